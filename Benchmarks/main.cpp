@@ -0,0 +1,548 @@
+#include "CompartmentHistory.h"
+#include "DiseaseParameters.h"
+#include "DiseaseModel.h"
+#include "Map.h"
+#include "Population.h"
+#include "Random.h"
+#include "SimulationTime.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Microbenchmarks of the hot paths of the simulation, for catching regressions and measuring optimizations
+//
+// Usage: Benchmarks [--populations N,N,...] [--map-scales N,N,...] [--repetitions N] [--threads N] [--seed N]
+//                   [--filter TEXT] [--brute-force-limit N] [--json FILE]
+//
+// Every benchmark runs for every population size and map scale (the map is generated for scale times more people
+// than live in it, so larger scales give larger, emptier cities). Results are printed as a table and, with --json,
+// written to FILE in a machine-readable form (FILE "-" writes them to stdout instead of the table).
+// The contact_pairs benchmarks compare the contact test on Vector2i distances with every batch kernel the processor supports.
+// The disease_classify benchmarks compare the search for healthy and infectious people of every compartment model
+// with the same loop written out for the SIR-D model (disease_classify_handwritten).
+
+const int RESIDENTS_LIMIT = 4;
+const int WARMUP_TICKS = 120;               // People leave their houses before the passes are timed
+const int INFECTED_PERCENTAGE = 10;         // Share of healthy people infected before the passes are timed
+const int COUNT_GETTER_CALLS = 1000;        // Calls of the count getters timed at once
+const int CONTACT_CANDIDATES = 1024;        // People in the batch every point is tested against
+const int CONTACT_POINTS = 1024;            // Points tested against the batch in a repetition
+const int CONTACT_AREA_SIZE = 400;          // Width in pixels of the square the people stand in (a few percent of the pairs are in contact)
+
+struct BenchmarkSettings
+{
+    std::vector<int> populationSizes = { 1000, 10000, 100000 };
+    std::vector<int> mapScales = { 1 };
+    int repetitions = 10;
+    int threadCount = 1;
+    unsigned int seed = 1;
+    std::string filter;
+    int bruteForceLimit = 20000;            // The brute force pass is quadratic, larger populations skip it
+    std::string jsonPath;
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    int populationSize;
+    int mapScale;
+    long long itemsPerRepetition;           // People, squares or calls processed by one repetition
+    std::vector<double> times;              // Nanoseconds of every repetition
+};
+
+// Map and population prepared for timing the passes of a tick, in the middle of an epidemic
+class BenchmarkScenario
+{
+public:
+    std::unique_ptr<Map> map;
+    std::unique_ptr<Population> population;
+
+    BenchmarkScenario(const BenchmarkSettings& settings, const DiseaseParameters& diseaseParameters, int populationSize, int mapScale)
+    {
+        SetRandomSeed(settings.seed);
+        map = std::make_unique<Map>(populationSize * mapScale, RESIDENTS_LIMIT);
+        map->GenerateMap();
+        map->GenerateBuildings();
+
+        DiseaseParameters parameters = diseaseParameters;
+        population = std::make_unique<Population>(populationSize, map.get(), parameters, RESIDENTS_LIMIT, settings.seed);
+        population->ChangePopulationParameters(&parameters);
+        population->SetTicksPerHour(DEFAULT_TICKS_PER_HOUR);
+        population->SetThreadCount(settings.threadCount);
+
+        // Send people out of their houses and infect every few healthy people
+        SimulationTime simulationTime;
+        for (int tick = 0; tick < WARMUP_TICKS; tick++) {
+            simulationTime.AdvanceTick();
+            if (simulationTime.HasHourChanged())
+                population->UpdatePopulationOnHour(simulationTime.GetHour());
+            population->UpdatePopulationOnTick();
+        }
+
+        PopulationStore& store = population->store;
+        int healthySeen = 0;
+        for (int i = 0; i < population->GetPeopleCount(); i++) {
+            if (store.states[i] == Healthy && healthySeen++ % (100 / INFECTED_PERCENTAGE) == 0) {
+                store.SetState(i, Infected);
+                store.infectionTicks[i] = store.tick;
+            }
+        }
+        population->diseaseProgression.Reschedule();
+    }
+
+    // One tick of changes of health and of walking for everyone (the simulation itself only moves the people it tests)
+    void UpdatePeople()
+    {
+        population->store.tick++;
+        population->diseaseProgression.ApplyEventsDue();
+        population->UpdatePositions();
+    }
+
+    void InfectPeople(InfectionMethod method)
+    {
+        population->SetInfectionMethod(method);
+        population->InfectPeople(population->store.tick);
+    }
+
+    void CollectInfectionCandidates(DiseaseModelType model)
+    {
+        population->store.diseaseModel = model;
+        population->CollectInfectionCandidates();
+    }
+
+    // The search of the SIR-D model without the model's policy, as it was written before the models
+    void CollectInfectionCandidatesHandwritten()
+    {
+        const PopulationStore& store = population->store;
+        std::vector<int>& healthyIndices = population->healthyIndices;
+        std::vector<int>& infectiousIndices = population->infectiousIndices;
+        infectiousIndices.clear();
+        healthyIndices.clear();
+        for (int i = 0; i < population->GetPeopleCount(); i++) {
+            if (store.states[i] == Healthy)
+                healthyIndices.push_back(i);
+            else if (store.states[i] == Infected && store.currentBuildings[i] != store.hospitalBuilding)
+                infectiousIndices.push_back(i);
+        }
+    }
+
+    std::pair<std::vector<int>, std::vector<int>> GetInfectionCandidates() const
+    {
+        return { population->healthyIndices, population->infectiousIndices };
+    }
+
+    void RescheduleDisease(DiseaseModelType model)
+    {
+        population->store.diseaseModel = model;
+        population->diseaseProgression.Reschedule();
+    }
+};
+
+// Keeps the compiler from removing the computation of a value that is never used
+volatile long long benchmarkSink;
+
+// Time repetitions of a function, setup runs before every repetition and is not timed
+BenchmarkResult Measure(const std::string& name, int populationSize, int mapScale, long long itemsPerRepetition, int repetitions,
+    const std::function<void()>& function, const std::function<void()>& setup = nullptr)
+{
+    BenchmarkResult result = { name, populationSize, mapScale, itemsPerRepetition, {} };
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        if (setup)
+            setup();
+        auto startTime = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::nano> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        result.times.push_back(elapsedTime.count());
+    }
+    return result;
+}
+
+struct Statistics
+{
+    double min;
+    double median;
+    double mean;
+    double standardDeviation;
+};
+
+Statistics GetStatistics(std::vector<double> times)
+{
+    std::sort(times.begin(), times.end());
+    Statistics statistics;
+    statistics.min = times.front();
+    size_t middle = times.size() / 2;
+    statistics.median = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2.0;
+
+    double sum = 0.0;
+    for (double time : times)
+        sum += time;
+    statistics.mean = sum / times.size();
+
+    double squaredDeviations = 0.0;
+    for (double time : times)
+        squaredDeviations += (time - statistics.mean) * (time - statistics.mean);
+    statistics.standardDeviation = times.size() > 1 ? std::sqrt(squaredDeviations / (times.size() - 1)) : 0.0;
+    return statistics;
+}
+
+// Contact tests of every point against a batch of people: the distance test on Vector2i used before
+// and every batch kernel the processor supports. All of them have to find the same contacts
+void RunContactBenchmarks(const BenchmarkSettings& settings, const DiseaseParameters& diseaseParameters, std::vector<BenchmarkResult>& results,
+    const std::function<bool(const char*)>& isSelected)
+{
+    bool anySelected = isSelected("contact_pairs_distance");
+    for (int type = 0; type < CONTACT_KERNEL_TYPE_COUNT; type++)
+        anySelected = anySelected || isSelected((std::string("contact_pairs_") + GetContactKernelName(static_cast<ContactKernelType>(type))).c_str());
+    if (!anySelected)
+        return;
+
+    std::mt19937 generator(settings.seed);
+    std::uniform_int_distribution<int> coordinateDistribution(0, CONTACT_AREA_SIZE - 1);
+    std::vector<Vector2i> candidates(CONTACT_CANDIDATES);
+    std::vector<int> candidateXs(CONTACT_CANDIDATES);
+    std::vector<int> candidateYs(CONTACT_CANDIDATES);
+    for (int i = 0; i < CONTACT_CANDIDATES; i++) {
+        candidates[i] = Vector2i(coordinateDistribution(generator), coordinateDistribution(generator));
+        candidateXs[i] = candidates[i].x;
+        candidateYs[i] = candidates[i].y;
+    }
+    std::vector<Vector2i> points(CONTACT_POINTS);
+    for (Vector2i& point : points)
+        point = Vector2i(coordinateDistribution(generator), coordinateDistribution(generator));
+
+    const long long pairs = static_cast<long long>(CONTACT_POINTS) * CONTACT_CANDIDATES;
+    long long distanceContacts = 0;
+    for (const Vector2i& point : points) {
+        for (const Vector2i& candidate : candidates)
+            distanceContacts += point.DistanceTo(candidate) < diseaseParameters.infectionRadius * 2;
+    }
+
+    if (isSelected("contact_pairs_distance")) {
+        results.push_back(Measure("contact_pairs_distance", 0, 0, pairs, settings.repetitions, [&] {
+            long long contacts = 0;
+            for (const Vector2i& point : points) {
+                for (const Vector2i& candidate : candidates)
+                    contacts += point.DistanceTo(candidate) < diseaseParameters.infectionRadius * 2;
+            }
+            benchmarkSink = contacts;
+        }));
+    }
+
+    int contactDistance = GetContactDistance(diseaseParameters.infectionRadius);
+    for (int type = 0; type < CONTACT_KERNEL_TYPE_COUNT; type++) {
+        ContactKernelType kernelType = static_cast<ContactKernelType>(type);
+        std::string name = std::string("contact_pairs_") + GetContactKernelName(kernelType);
+        if (!IsContactKernelSupported(kernelType) || !isSelected(name.c_str()))
+            continue;
+
+        ContactCountFunction countContacts = GetContactKernel(kernelType);
+        long long contacts = 0;
+        for (const Vector2i& point : points)
+            contacts += countContacts(point.x, point.y, candidateXs.data(), candidateYs.data(), CONTACT_CANDIDATES, contactDistance);
+        if (contacts != distanceContacts)
+            throw std::logic_error(name + " finds " + std::to_string(contacts) + " contacts instead of " + std::to_string(distanceContacts));
+
+        results.push_back(Measure(name, 0, 0, pairs, settings.repetitions, [&] {
+            long long sum = 0;
+            for (const Vector2i& point : points)
+                sum += countContacts(point.x, point.y, candidateXs.data(), candidateYs.data(), CONTACT_CANDIDATES, contactDistance);
+            benchmarkSink = sum;
+        }));
+    }
+}
+
+void RunBenchmarks(const BenchmarkSettings& settings, const DiseaseParameters& diseaseParameters, std::vector<BenchmarkResult>& results)
+{
+    auto isSelected = [&](const char* name) { return settings.filter.empty() || std::strstr(name, settings.filter.c_str()); };
+
+    for (int populationSize : settings.populationSizes) {
+        for (int mapScale : settings.mapScales) {
+            int mapPopulation = populationSize * mapScale;
+
+            if (isSelected("map_generate")) {
+                std::unique_ptr<Map> map = std::make_unique<Map>(mapPopulation, RESIDENTS_LIMIT);
+                long long squares = static_cast<long long>(map->GetMapWidth()) * map->GetMapWidth();
+                results.push_back(Measure("map_generate", populationSize, mapScale, squares, settings.repetitions,
+                    [&] { map->GenerateMap(); },
+                    [&] { SetRandomSeed(settings.seed); map = std::make_unique<Map>(mapPopulation, RESIDENTS_LIMIT); }));
+            }
+
+            if (isSelected("map_buildings")) {
+                std::unique_ptr<Map> map = std::make_unique<Map>(mapPopulation, RESIDENTS_LIMIT);
+                long long squares = static_cast<long long>(map->GetMapWidth()) * map->GetMapWidth();
+                results.push_back(Measure("map_buildings", populationSize, mapScale, squares, settings.repetitions,
+                    [&] { map->GenerateBuildings(); },
+                    [&] { SetRandomSeed(settings.seed); map = std::make_unique<Map>(mapPopulation, RESIDENTS_LIMIT); map->GenerateMap(); }));
+            }
+
+            if (isSelected("population_construct")) {
+                SetRandomSeed(settings.seed);
+                Map map(mapPopulation, RESIDENTS_LIMIT);
+                map.GenerateMap();
+                map.GenerateBuildings();
+                std::unique_ptr<Population> population;
+                results.push_back(Measure("population_construct", populationSize, mapScale, populationSize, settings.repetitions,
+                    [&] { population = std::make_unique<Population>(populationSize, &map, diseaseParameters, RESIDENTS_LIMIT, settings.seed); },
+                    [&] { population.reset(); }));
+            }
+
+            bool needsScenario = isSelected("person_update") || isSelected("population_hour") || isSelected("infection_pass") || isSelected("population_tick")
+                || isSelected("count_getters") || isSelected("disease_");
+            if (!needsScenario)
+                continue;
+
+            // Passes of a tick change the population, so every benchmark starts from the same fresh scenario
+            auto scenario = std::make_unique<BenchmarkScenario>(settings, diseaseParameters, populationSize, mapScale);
+            auto freshScenario = [&] { scenario = std::make_unique<BenchmarkScenario>(settings, diseaseParameters, populationSize, mapScale); };
+
+            if (isSelected("person_update")) {
+                results.push_back(Measure("person_update", populationSize, mapScale, populationSize, settings.repetitions,
+                    [&] { scenario->UpdatePeople(); }));
+                freshScenario();
+            }
+
+            // A whole day of hourly updates, so every hour of the schedules is included
+            if (isSelected("population_hour")) {
+                results.push_back(Measure("population_hour", populationSize, mapScale, 24LL * populationSize, settings.repetitions, [&] {
+                    for (int hour = 0; hour < 24; hour++)
+                        scenario->population->UpdatePopulationOnHour(hour);
+                }));
+                freshScenario();
+            }
+
+            if (isSelected("infection_pass_grid")) {
+                results.push_back(Measure("infection_pass_grid", populationSize, mapScale, populationSize, settings.repetitions,
+                    [&] { scenario->InfectPeople(UniformGrid); }));
+                freshScenario();
+            }
+
+            if (isSelected("infection_pass_buildings")) {
+                results.push_back(Measure("infection_pass_buildings", populationSize, mapScale, populationSize, settings.repetitions,
+                    [&] { scenario->InfectPeople(BuildingOccupancy); }));
+                freshScenario();
+            }
+
+            if (isSelected("infection_pass_brute_force") && populationSize <= settings.bruteForceLimit) {
+                results.push_back(Measure("infection_pass_brute_force", populationSize, mapScale, populationSize, settings.repetitions,
+                    [&] { scenario->InfectPeople(BruteForce); }));
+                freshScenario();
+            }
+
+            // The searches only read the population, so they share the scenario
+            if (isSelected("disease_classify")) {
+                scenario->CollectInfectionCandidates(SIRD_MODEL);
+                auto modelCandidates = scenario->GetInfectionCandidates();
+                scenario->CollectInfectionCandidatesHandwritten();
+                if (scenario->GetInfectionCandidates() != modelCandidates)
+                    throw std::logic_error("The SIR-D model finds other people than the handwritten search");
+            }
+            if (isSelected("disease_classify_handwritten")) {
+                results.push_back(Measure("disease_classify_handwritten", populationSize, mapScale, populationSize, settings.repetitions,
+                    [&] { scenario->CollectInfectionCandidatesHandwritten(); }));
+            }
+            for (int type = 0; type < DISEASE_MODEL_TYPE_COUNT; type++) {
+                DiseaseModelType model = static_cast<DiseaseModelType>(type);
+                std::string modelName = GetDiseaseModelName(model);
+                modelName.erase(std::remove(modelName.begin(), modelName.end(), '-'), modelName.end());
+                if (isSelected(("disease_classify_" + modelName).c_str())) {
+                    results.push_back(Measure("disease_classify_" + modelName, populationSize, mapScale, populationSize, settings.repetitions,
+                        [&] { scenario->CollectInfectionCandidates(model); }));
+                }
+                if (isSelected(("disease_reschedule_" + modelName).c_str())) {
+                    results.push_back(Measure("disease_reschedule_" + modelName, populationSize, mapScale, scenario->population->GetInfectedCount(), settings.repetitions,
+                        [&] { scenario->RescheduleDisease(model); }));
+                }
+            }
+            scenario->RescheduleDisease(SIRD_MODEL);
+
+            if (isSelected("population_tick")) {
+                scenario->population->SetInfectionMethod(UniformGrid);
+                results.push_back(Measure("population_tick", populationSize, mapScale, populationSize, settings.repetitions,
+                    [&] { scenario->population->UpdatePopulationOnTick(); }));
+            }
+
+            if (isSelected("count_getters")) {
+                const Population& population = *scenario->population;
+                results.push_back(Measure("count_getters", populationSize, mapScale, COUNT_GETTER_CALLS, settings.repetitions, [&] {
+                    long long sum = 0;
+                    for (int call = 0; call < COUNT_GETTER_CALLS; call++) {
+                        CompartmentCounts counts = population.GetCompartmentCounts();
+                        sum += counts.healthy + counts.infected + population.GetImmuneCount() + population.GetDeadCount();
+                    }
+                    benchmarkSink = sum;
+                }));
+            }
+        }
+    }
+
+    // The graph's history does not depend on the population size
+    if (isSelected("history_add_sample")) {
+        const int samples = 100000;
+        CompartmentHistory history(1200, 4096);
+        results.push_back(Measure("history_add_sample", 0, 0, samples, settings.repetitions, [&] {
+            for (int sample = 0; sample < samples; sample++)
+                history.AddSample({ sample, sample / 2, sample / 4, sample / 8, sample / 16 });
+        }));
+    }
+
+    RunContactBenchmarks(settings, diseaseParameters, results, isSelected);
+}
+
+void PrintResults(const std::vector<BenchmarkResult>& results)
+{
+    std::cout << std::left << std::setw(28) << "benchmark" << std::right << std::setw(12) << "population" << std::setw(6) << "scale"
+        << std::setw(14) << "median ms" << std::setw(14) << "min ms" << std::setw(12) << "stddev %" << std::setw(14) << "ns per item"
+        << std::setw(16) << "M items per s" << std::endl;
+    for (const BenchmarkResult& result : results) {
+        Statistics statistics = GetStatistics(result.times);
+        std::cout << std::left << std::setw(28) << result.name << std::right << std::setw(12) << result.populationSize << std::setw(6) << result.mapScale
+            << std::fixed << std::setprecision(3) << std::setw(14) << statistics.median / 1e6 << std::setw(14) << statistics.min / 1e6
+            << std::setprecision(1) << std::setw(12) << 100.0 * statistics.standardDeviation / statistics.mean
+            << std::setprecision(2) << std::setw(14) << statistics.median / result.itemsPerRepetition
+            << std::setw(16) << 1e3 * result.itemsPerRepetition / statistics.median << std::defaultfloat << std::endl;
+    }
+}
+
+void WriteJson(std::ostream& output, const BenchmarkSettings& settings, const std::vector<BenchmarkResult>& results)
+{
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+
+    output << std::setprecision(10);
+    output << "{\n  \"context\": {\n";
+    output << "    \"date\": \"" << date << "\",\n";
+    output << "    \"build_type\": \"" << buildType << "\",\n";
+    output << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    output << "    \"threads\": " << settings.threadCount << ",\n";
+    output << "    \"seed\": " << settings.seed << ",\n";
+    output << "    \"repetitions\": " << settings.repetitions << "\n  },\n";
+    output << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        Statistics statistics = GetStatistics(result.times);
+        output << (i > 0 ? "," : "") << "\n    {\n";
+        output << "      \"name\": \"" << result.name << "\",\n";
+        output << "      \"population\": " << result.populationSize << ",\n";
+        output << "      \"map_scale\": " << result.mapScale << ",\n";
+        output << "      \"items_per_repetition\": " << result.itemsPerRepetition << ",\n";
+        output << "      \"min_ns\": " << statistics.min << ",\n";
+        output << "      \"median_ns\": " << statistics.median << ",\n";
+        output << "      \"mean_ns\": " << statistics.mean << ",\n";
+        output << "      \"stddev_ns\": " << statistics.standardDeviation << ",\n";
+        output << "      \"ns_per_item\": " << statistics.median / result.itemsPerRepetition << ",\n";
+        output << "      \"items_per_second\": " << 1e9 * result.itemsPerRepetition / statistics.median << ",\n";
+        output << "      \"times_ns\": [";
+        for (size_t repetition = 0; repetition < result.times.size(); repetition++)
+            output << (repetition > 0 ? ", " : "") << result.times[repetition];
+        output << "]\n    }";
+    }
+    output << "\n  ]\n}" << std::endl;
+}
+
+std::vector<int> ParseList(const std::string& text)
+{
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string value;
+    while (std::getline(stream, value, ','))
+        values.push_back(std::stoi(value));
+    if (values.empty() || *std::min_element(values.begin(), values.end()) <= 0)
+        throw std::invalid_argument("List must contain positive numbers");
+    return values;
+}
+
+void PrintUsage()
+{
+    std::cout << "Usage: Benchmarks [--populations N,N,...] [--map-scales N,N,...] [--repetitions N] [--threads N] [--seed N]"
+        << " [--filter TEXT] [--brute-force-limit N] [--json FILE]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkSettings settings;
+
+    // The same disease as in the headless simulator
+    DiseaseParameters diseaseParameters;
+    diseaseParameters.infectionProbabilityPerHour = 0.05f;
+    diseaseParameters.deathProbabilityPerHour = 0.005f;
+    diseaseParameters.hoursToGetImmune = 24.0f;
+    diseaseParameters.hoursToGetSymptoms = 12.0f;
+    diseaseParameters.hoursToGetInfectious = 6.0f;
+    diseaseParameters.infectionRadius = 20.0f;
+    diseaseParameters.probabilityOfGoingToHospitalPerHour = 0.01f;
+    diseaseParameters.deathProbabilityPerHourInHospital = 0.002f;
+
+    // Read command line arguments
+    try {
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--populations") == 0 && i + 1 < argc)
+                settings.populationSizes = ParseList(argv[++i]);
+            else if (std::strcmp(argv[i], "--map-scales") == 0 && i + 1 < argc)
+                settings.mapScales = ParseList(argv[++i]);
+            else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc)
+                settings.repetitions = std::max(1, std::stoi(argv[++i]));
+            else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                settings.threadCount = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+                settings.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+                settings.filter = argv[++i];
+            else if (std::strcmp(argv[i], "--brute-force-limit") == 0 && i + 1 < argc)
+                settings.bruteForceLimit = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+                settings.jsonPath = argv[++i];
+            else {
+                PrintUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        std::vector<BenchmarkResult> results;
+        RunBenchmarks(settings, diseaseParameters, results);
+
+        if (settings.jsonPath == "-") {
+            WriteJson(std::cout, settings, results);
+            return 0;
+        }
+
+        PrintResults(results);
+        if (!settings.jsonPath.empty()) {
+            std::ofstream file(settings.jsonPath, std::ios::trunc);
+            WriteJson(file, settings, results);
+            if (!file)
+                throw std::runtime_error("Can't write " + settings.jsonPath);
+        }
+    }
+    catch (const std::exception& exception) {
+        std::cerr << "Benchmark failed: " << exception.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
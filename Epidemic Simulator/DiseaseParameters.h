@@ -1,12 +0,0 @@
-#pragma once
-
-struct DiseaseParameters
-{
-    float infectionProbabilityPerHour;
-    float deathProbabilityPerHour;
-    float deathProbabilityPerHourInHospital;
-    float probabilityOfGoingToHospitalPerHour;
-    float hoursToGetImmune;
-    float hoursToGetSymptoms;
-    float infectionRadius;
-};
\ No newline at end of file
@@ -1,58 +1,33 @@
 #include "Graph.h"
-#include "Population.h"
+#include <algorithm>
+#include <cmath>
 // parametry konstruktora klasy Rectangle:
 // raylib::Rectangle(float x, float y, float width, float height)
 // 
-//-------------------- DataColumn ----------------------------
-DataColumn::DataColumn(float x, float y, float w, float h, Population* population) {
-	posX = x;
-	posY = y;
-	width = w;
-	height = h;
-
-	// update simulation parameters here
-	float RatioHealthy = population->GetHealthyCount() / Population::populationCount;
-	float RatioInfected = population->GetInfectedCount() / Population::populationCount;
-	float RatioImmune = population->GetImmuneCount() / Population::populationCount;
-	float RatioDead = population->GetDeadCount() / Population::populationCount;
-
-	healthy = { posX, posY, width, height * RatioHealthy };
-	immune = { posX, posY + height * RatioHealthy, width, height * RatioImmune };
-	infected = { posX, posY + height * (RatioHealthy + RatioImmune), width, height * RatioInfected};
-	dead = { posX, posY + height * (RatioHealthy + RatioImmune + RatioInfected), width, height * RatioDead };
-}
-
-void DataColumn::drawDataColumn() {
-	healthy.Draw(raylib::Color::Green());
-	immune.Draw(raylib::Color::Blue());
-	infected.Draw(raylib::Color::Red());
-	dead.Draw(raylib::Color::Black());
-}
-
 //-------------------- TimeUnit ----------------------------
-TimeUnit::TimeUnit(float x, float y, float w, float h, int hour) {
+TimeUnit::TimeUnit(float x, float y, float w, float h, const std::string& text) {
 	posX = x;
 	posY = y;
 	width = w;
 	height = h;
-	hourCount = hour;
+	label = text;
 }
 
 void TimeUnit::drawTimeUnit() {
 	raylib::Color::Black().DrawRectangle(posX, posY, width, height);
-	raylib::Color::Black().DrawText(std::to_string(hourCount) + ":00", posX - 10 - 7, posY + 15, 19);
+	raylib::Color::Black().DrawText(label, posX - 10 - 7, posY + 15, 19);
 }
 
 //-------------------- Graph ----------------------------
-Graph::Graph(float x, float y, float w, float h) {
+Graph::Graph(float x, float y, float w, float h, int ticksPerHour) : history(static_cast<int>(w - axisWidth), static_cast<int>(w - axisWidth)), ticksPerHour(ticksPerHour) {
 	posX = x;
 	posY = y;
 	width = w;
 	height = h;
 
-	xAxisLine = { posX, posY + height, width, axisWidth}; 
-	yAxisLineLeft = { posX, posY, axisWidth, height };
-	yAxisLineRight = { posX + width, posY, axisWidth, height };
+	xAxisLine = raylib::Rectangle(posX, posY + height, width, axisWidth);
+	yAxisLineLeft = raylib::Rectangle(posX, posY, axisWidth, height);
+	yAxisLineRight = raylib::Rectangle(posX + width, posY, axisWidth, height);
 }
 
 float Graph::getPosX() { return posX; }
@@ -77,61 +52,71 @@ void Graph::drawGraph() {
 		raylib::Color::Black().DrawText(std::to_string(percentageY) + "%", posX + width + axisWidth + 15, i - 6, 19);
 	}
 
-	// collumnCollection
-	for (int i = 0; i < columnCollection.size(); i++) {
-		columnCollection[i].drawDataColumn();
-	} 
-
-	// timeUnitCollection
-	for (int i = 0; i < unitCollection.size(); i++) {
-		unitCollection[i].drawTimeUnit();
-	}
+	if (showHistory)
+		drawHistory();
+	else
+		drawRecent();
 }
 
-// phase 1 - initial graph fill-in:
-void Graph::updateGraphStart(int* filler, float simulationTime, Population* population) {
-	int simulationMinutes = trunc(ceil(simulationTime * 60.f));
-	// columns:
-	columnCollection.push_back(DataColumn(posX + 5 + *filler, posY, 1, height, population));
-	
-	// time units:
-	if (*filler % simulationMinutes == 0) {
-		unitCollection.push_back(TimeUnit(posX + *filler, posY + height + axisWidth,
-		5, 10, (*filler/simulationMinutes) ));
-	}
+// single 1-pixel wide column of population data
+void Graph::drawDataColumn(float x, const CompartmentCounts& counts) {
+	float total = static_cast<float>(counts.healthy + counts.exposed + counts.infected + counts.immune + counts.dead);
+	if (total == 0)
+		return;
 
-	*filler += 1;
+	float ratioHealthy = counts.healthy / total;
+	float ratioExposed = counts.exposed / total;
+	float ratioInfected = counts.infected / total;
+	float ratioImmune = counts.immune / total;
+	float ratioDead = counts.dead / total;
+
+	raylib::Rectangle(x, posY, 1, height * ratioHealthy).Draw(raylib::Color::Green());
+	raylib::Rectangle(x, posY + height * ratioHealthy, 1, height * ratioImmune).Draw(raylib::Color::Blue());
+	raylib::Rectangle(x, posY + height * (ratioHealthy + ratioImmune), 1, height * ratioExposed).Draw(raylib::Color::Orange());
+	raylib::Rectangle(x, posY + height * (ratioHealthy + ratioImmune + ratioExposed), 1, height * ratioInfected).Draw(raylib::Color::Red());
+	raylib::Rectangle(x, posY + height * (ratioHealthy + ratioImmune + ratioExposed + ratioInfected), 1, height * ratioDead).Draw(raylib::Color::Black());
 }
 
-// phase 2 - graph scrolling
-void Graph::updateGraph(int* framecounter, float simulationTime, Population* population) {
-	int simulationMinutes = trunc(ceil(simulationTime * 60.f));
-	
-	// Columns:
-	// delete the first data column
-	columnCollection.erase(columnCollection.begin());
-	// re-align all the other columns to the left
-	for (int i = 0; i < columnCollection.size(); i++) {
-		columnCollection[i].healthy.x -= 1;
-		columnCollection[i].infected.x -= 1;
-		columnCollection[i].immune.x -= 1;
-		columnCollection[i].dead.x -= 1;
-	}
-	// draw the last data column with updated simulation parameters (done inside the column constructor)
-	columnCollection.push_back(DataColumn(posX + width - 1, posY, 1, height, population));
+// last ticks, one column per tick with the hour marked below
+void Graph::drawRecent() {
+	raylib::Color::Black().DrawText("Recent hours (H - whole simulation)", posX, posY - 30, 19);
 
-	// Time units:
-	// delete all timeunits outside the graph range
-	if (unitCollection[0].posX < (posX + 5)) {
-		unitCollection.erase(unitCollection.begin());
-	}
-	// move every timeUnit a pixel to the left
-	for (int i = 0; i < unitCollection.size(); i++) {
-		unitCollection[i].posX -= 1;
+	for (int i = 0; i < history.GetRecentCount(); i++) {
+		drawDataColumn(posX + axisWidth + i, history.GetRecentSample(i));
+
+		uint64_t tick = history.GetRecentFirstTick() + i;
+		if (tick % ticksPerHour == 0) {
+			int hour = static_cast<int>((tick / ticksPerHour) % 24);
+			TimeUnit(posX + axisWidth + i - 2, posY + height + axisWidth, 5, 10, std::to_string(hour) + ":00").drawTimeUnit();
+		}
 	}
-	// draw a new timeUnit every simulation tick (1 hour = 1 second)
-	if (*framecounter % simulationMinutes == 0) {
-		unitCollection.push_back(TimeUnit(posX + width - 5, posY + height + axisWidth,
-			5, 10, *framecounter / simulationMinutes));
+}
+
+// whole simulation at the resolution of the history, with days marked below
+void Graph::drawHistory() {
+	raylib::Color::Black().DrawText("Whole simulation (H - recent hours)", posX, posY - 30, 19);
+
+	uint64_t ticksPerDay = 24 * static_cast<uint64_t>(ticksPerHour);
+	uint64_t interval = history.GetHistoryInterval();
+
+	// label only every few days, so the labels don't overlap
+	float pixelsPerDay = static_cast<float>(ticksPerDay) / interval;
+	uint64_t dayStep = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(60.0f / pixelsPerDay)));
+
+	for (int i = 0; i < history.GetHistoryCount(); i++) {
+		drawDataColumn(posX + axisWidth + i, history.GetHistorySample(i));
+
+		uint64_t day = (i * interval) / ticksPerDay;
+		bool dayStarts = i == 0 || day != ((i - 1) * interval) / ticksPerDay;
+		if (dayStarts && day % dayStep == 0)
+			TimeUnit(posX + axisWidth + i - 2, posY + height + axisWidth, 5, 10, "Day " + std::to_string(day + 1)).drawTimeUnit();
 	}
 }
+
+void Graph::addSample(const CompartmentCounts& counts) {
+	history.AddSample(counts);
+}
+
+void Graph::toggleHistoryView() {
+	showHistory = !showHistory;
+}
\ No newline at end of file
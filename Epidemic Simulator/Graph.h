@@ -1,42 +1,28 @@
 #pragma once
 
 #include "raylib-cpp.hpp"
-#include "Population.h"
+#include "CompartmentHistory.h"
 #include <iostream>
 #include <string>
 #include <vector>
 
-// 1-pixel wide column of population data visible on the graph
-class DataColumn {
-private:
-	float posX{}, posY{};
-	float width = 1, height{};
-	raylib::Rectangle healthy;
-	raylib::Rectangle infected;
-	raylib::Rectangle immune;
-	raylib::Rectangle dead;
-public:
-	DataColumn(float x, float y, float w, float h, Population* population);
-	virtual ~DataColumn() {};
-
-	void drawDataColumn();
-	friend class Graph;
-};
-
-// hour count displayed on the x-axis
+// time label displayed on the x-axis
 class TimeUnit {
 private:
 	float posX{}, posY{};
 	float width = 5, height = 10;
-	int hourCount;
+	std::string label;
 public:
-	TimeUnit(float x, float y, float w, float h, int hour);
+	TimeUnit(float x, float y, float w, float h, const std::string& text);
 	virtual ~TimeUnit() {};
 
 	void drawTimeUnit();
 	friend class Graph;
 };
 
+// Graph of the compartment counts. The recent view shows the last ticks (one 1-pixel wide column per tick),
+// the history view shows the whole simulation at a lower resolution. Columns are placed when drawing,
+// so adding a sample doesn't move anything.
 class Graph {
 private:
 	float posX{}, posY{};
@@ -45,10 +31,15 @@ private:
 	raylib::Rectangle xAxisLine;
 	raylib::Rectangle yAxisLineLeft;
 	raylib::Rectangle yAxisLineRight;
-	std::vector<DataColumn> columnCollection;
-	std::vector<TimeUnit> unitCollection;
+	CompartmentHistory history;
+	int ticksPerHour;
+	bool showHistory = false;
+
+	void drawDataColumn(float x, const CompartmentCounts& counts);
+	void drawRecent();
+	void drawHistory();
 public:
-	Graph(float x, float y, float w, float h);
+	Graph(float x, float y, float w, float h, int ticksPerHour);
 	virtual ~Graph() {};
 
 	float getPosX();
@@ -58,6 +49,6 @@ public:
 	float getAxisWidth();
 
 	void drawGraph();
-	void updateGraphStart(int* filler, float simulationTime, Population* population); // initial fill-in
-	void updateGraph(int* framecounter, float simulationTime, Population* population); // normal graph updates
+	void addSample(const CompartmentCounts& counts); // called after every simulation tick
+	void toggleHistoryView(); // switch between the recent ticks and the whole simulation
 };
\ No newline at end of file
@@ -0,0 +1,315 @@
+#include "MapRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+MapRenderer::MapRenderer() : houseTexture("resources/house_icon.png"), shopTexture("resources/shop_icon.png"), hospitalTexture("resources/hospital_icon.png"), workplaceTexture("resources/workplace_icon.png"),
+	cached(true), tilesMap(nullptr), tilesMapGeneration(0), tileScale(1.0f), frame(0)
+{
+	if (!houseTexture.IsValid() || !shopTexture.IsValid() || !workplaceTexture.IsValid() || !hospitalTexture.IsValid())
+		throw std::runtime_error("Failed to load building textures.");
+}
+
+// Find the range of map squares overlapping the view, false if the view does not overlap the map at all
+bool MapRenderer::GetVisibleSquares(const Map& map, const Rectangle& view, Vector2i& firstSquare, Vector2i& lastSquare) const
+{
+	float halfMapPixelSize = map.GetMapPixelSize() / 2.0f;
+	if (view.x > halfMapPixelSize || view.y > halfMapPixelSize || view.x + view.width < -halfMapPixelSize || view.y + view.height < -halfMapPixelSize)
+		return false;
+
+	firstSquare = map.PixelToSquarePosition({ static_cast<int>(std::floor(view.x)), static_cast<int>(std::floor(view.y)) });
+	lastSquare = map.PixelToSquarePosition({ static_cast<int>(std::ceil(view.x + view.width)), static_cast<int>(std::ceil(view.y + view.height)) });
+	return true;
+}
+
+// Find the range of tiles overlapping the view, false if the view does not overlap the map at all
+bool MapRenderer::GetVisibleTiles(const Map& map, const Rectangle& view, Vector2i& firstTile, Vector2i& lastTile) const
+{
+	float halfMapPixelSize = map.GetMapPixelSize() / 2.0f;
+	if (view.x > halfMapPixelSize || view.y > halfMapPixelSize || view.x + view.width < -halfMapPixelSize || view.y + view.height < -halfMapPixelSize)
+		return false;
+
+	float tileWorldSize = GetTileWorldSize();
+	int tilesAcross = static_cast<int>(std::ceil(map.GetMapPixelSize() / tileWorldSize));
+	auto toTile = [&](float position) {
+		return std::clamp(static_cast<int>(std::floor((position + halfMapPixelSize) / tileWorldSize)), 0, tilesAcross - 1);
+	};
+
+	firstTile = { toTile(view.x), toTile(view.y) };
+	lastTile = { toTile(view.x + view.width), toTile(view.y + view.height) };
+	return true;
+}
+
+const MapTile* MapRenderer::FindTile(Vector2i position) const
+{
+	for (const MapTile& tile : tiles)
+	{
+		if (tile.position.x == position.x && tile.position.y == position.y)
+			return &tile;
+	}
+	return nullptr;
+}
+
+// Draw the part of the map covered by the tile into its render texture, reusing the least recently drawn tile when the cache is full
+void MapRenderer::BakeTile(const Map& map, Vector2i position)
+{
+	MapTile* tile = nullptr;
+	if (tiles.size() >= MAX_MAP_TILES)
+	{
+		auto oldestTile = std::min_element(tiles.begin(), tiles.end(),
+			[](const MapTile& a, const MapTile& b) { return a.lastUsedFrame < b.lastUsedFrame; });
+		if (oldestTile->lastUsedFrame < frame)
+			tile = &*oldestTile;
+	}
+	if (!tile)
+	{
+		tiles.push_back({ position, raylib::RenderTexture(MAP_TILE_TEXTURE_SIZE, MAP_TILE_TEXTURE_SIZE), frame });
+		if (!tiles.back().texture.IsValid())
+		{
+			tiles.pop_back();
+			throw std::runtime_error("Failed to create render texture of a map tile.");
+		}
+		tile = &tiles.back();
+	}
+	tile->position = position;
+	tile->lastUsedFrame = frame;
+
+	float tileWorldSize = GetTileWorldSize();
+	float halfMapPixelSize = map.GetMapPixelSize() / 2.0f;
+	raylib::Rectangle tileRectangle(position.x * tileWorldSize - halfMapPixelSize, position.y * tileWorldSize - halfMapPixelSize, tileWorldSize, tileWorldSize);
+
+	raylib::Camera2D tileCamera(raylib::Vector2(0, 0), raylib::Vector2(tileRectangle.x, tileRectangle.y), 0.0f, tileScale);
+	tile->texture.BeginMode();
+	ClearBackground(BLANK);
+	tileCamera.BeginMode();
+	DrawBlocks(map, tileRectangle);
+	DrawBuildings(map, tileRectangle);
+	tileCamera.EndMode();
+	tile->texture.EndMode();
+
+	GenTextureMipmaps(&tile->texture.texture);
+	SetTextureFilter(tile->texture.texture, TEXTURE_FILTER_TRILINEAR);
+}
+
+void MapRenderer::UpdateTiles(const Map& map, const Rectangle& view, float cameraZoom)
+{
+	frame++;
+	if (!cached)
+		return;
+
+	// Tiles are baked at the power of two scale nearest above the zoom, so they are never magnified and at most halved
+	float newTileScale = std::clamp(std::exp2(std::ceil(std::log2(cameraZoom))), MIN_MAP_TILE_SCALE, 1.0f);
+	if (tilesMap != &map || tilesMapGeneration != map.GetGeneration() || tileScale != newTileScale)
+	{
+		tiles.clear();
+		tilesMap = &map;
+		tilesMapGeneration = map.GetGeneration();
+		tileScale = newTileScale;
+	}
+
+	Vector2i firstTile, lastTile;
+	if (!GetVisibleTiles(map, view, firstTile, lastTile))
+		return;
+
+	// Baking is spread over frames, so that a change of the zoom level does not stall a single frame
+	int bakedTiles = 0;
+	for (int y = firstTile.y; y <= lastTile.y; y++)
+	{
+		for (int x = firstTile.x; x <= lastTile.x; x++)
+		{
+			auto tile = std::find_if(tiles.begin(), tiles.end(), [&](const MapTile& cachedTile) { return cachedTile.position.x == x && cachedTile.position.y == y; });
+			if (tile != tiles.end())
+				tile->lastUsedFrame = frame;
+			else if (bakedTiles < MAX_MAP_TILE_BAKES_PER_FRAME)
+			{
+				BakeTile(map, { x, y });
+				bakedTiles++;
+			}
+		}
+	}
+}
+
+// Draw the map, from the baked tiles in cached mode or block by block otherwise
+void MapRenderer::DrawMap(const Map& map, const Rectangle& view) const
+{
+	if (!cached || tilesMap != &map || tilesMapGeneration != map.GetGeneration())
+	{
+		DrawBlocks(map, view);
+		DrawBuildings(map, view);
+		return;
+	}
+
+	Vector2i firstTile, lastTile;
+	if (!GetVisibleTiles(map, view, firstTile, lastTile))
+		return;
+
+	float tileWorldSize = GetTileWorldSize();
+	float halfMapPixelSize = map.GetMapPixelSize() / 2.0f;
+	raylib::Rectangle sourceRectangle(0, 0, MAP_TILE_TEXTURE_SIZE, -MAP_TILE_TEXTURE_SIZE); // Render textures are upside down
+	Vector2 origin = { 0, 0 };
+
+	for (int y = firstTile.y; y <= lastTile.y; y++)
+	{
+		for (int x = firstTile.x; x <= lastTile.x; x++)
+		{
+			raylib::Rectangle tileRectangle(x * tileWorldSize - halfMapPixelSize, y * tileWorldSize - halfMapPixelSize, tileWorldSize, tileWorldSize);
+			const MapTile* tile = FindTile({ x, y });
+
+			// Tiles that are not baked yet are drawn block by block
+			if (tile)
+				DrawTexturePro(tile->texture.texture, sourceRectangle, tileRectangle, origin, 0.0f, WHITE);
+			else
+			{
+				raylib::Rectangle visibleRectangle = tileRectangle.GetCollision(view);
+				DrawBlocks(map, visibleRectangle);
+				DrawBuildings(map, visibleRectangle);
+			}
+		}
+	}
+}
+
+// Draw the map blocks on the screen
+void MapRenderer::DrawBlocks(const Map& map, const Rectangle& view) const
+{
+	Vector2i firstSquare, lastSquare;
+	if (!GetVisibleSquares(map, view, firstSquare, lastSquare))
+		return;
+
+	// Draw the part of main city rectangle inside the view
+	float mapPixelSize = static_cast<float>(map.GetMapPixelSize());
+	raylib::Rectangle cityRectangle(-mapPixelSize / 2, -mapPixelSize / 2, mapPixelSize, mapPixelSize);
+	BACKGROUND_COLOR.DrawRectangle(cityRectangle.GetCollision(view));
+
+	// Draw the blocks covering visible squares. A block spanning several squares is drawn once,
+	// from the first of its squares inside the visible range
+	const std::vector<MapBlock>& mapBlocksList = map.GetMapBlocksList();
+	for (int y = firstSquare.y; y <= lastSquare.y; y++)
+	{
+		for (int x = firstSquare.x; x <= lastSquare.x; x++)
+		{
+			int blockIndex = map.GetBlockIndexAt({ x, y });
+			if (blockIndex < 0)
+				continue;
+
+			const MapBlock& block = mapBlocksList[blockIndex];
+			Vector2i baseSquare = block.GetOccupiedSquares().front();
+			if (x == std::max(baseSquare.x, firstSquare.x) && y == std::max(baseSquare.y, firstSquare.y))
+				DrawBlock(map, block);
+		}
+	}
+}
+
+void MapRenderer::DrawBlock(const Map& map, const MapBlock& block) const
+{
+	const int SQUARE_WIDTH = map.GetSquareWidth();
+	const int ROAD_WIDTH = map.GetRoadWidth();
+	int mapPixelSize = map.GetMapPixelSize();
+
+	// x and y coordinates of the point where main city rectangle starts to be drawn (top left corner)
+	int citySquareOriginX = -mapPixelSize / 2;
+	int citySquareOriginY = -mapPixelSize / 2;
+
+	// Get the origin of base occupied square
+	Vector2i occupiedSquare = block.GetOccupiedSquares().front();
+	int baseBlockOriginX = citySquareOriginX + ROAD_WIDTH + occupiedSquare.x * (SQUARE_WIDTH + ROAD_WIDTH);
+	int baseBlockOriginY = citySquareOriginY + ROAD_WIDTH + occupiedSquare.y * (SQUARE_WIDTH + ROAD_WIDTH);
+
+	// Determine the color of the block and the type of building
+	raylib::Color drawColor;
+
+	switch (block.GetAreaType())
+	{
+	case AreaType::GREEN_AREA:
+		drawColor = GREEN_AREA_COLOR;
+		break;
+	case AreaType::RESIDENTIAL_AREA:
+		drawColor = RESIDENTIAL_AREA_COLOR;
+		break;
+	case AreaType::HOSPITAL:
+		drawColor = HOSPITAL_AREA_COLOR;
+		break;
+	case AreaType::SHOPPING_AREA:
+		drawColor = SHOPPING_AREA_COLOR;
+		break;
+	case AreaType::WORKPLACE_AREA:
+		drawColor = WORKPLACE_AREA_COLOR;
+		break;
+	default:
+		// EXCEPTION MISSING
+		return;
+	}
+
+	// Draw the block based on its size
+	switch (block.GetBlockSize())
+	{
+	case Size::STANDARD:
+		drawColor.DrawRectangle(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH, SQUARE_WIDTH);
+		break;
+
+	case Size::DOUBLE_VERTICAL:
+		drawColor.DrawRectangle(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH, SQUARE_WIDTH * 2 + ROAD_WIDTH);
+		break;
+
+	case Size::DOUBLE_HORIZONTAL:
+		drawColor.DrawRectangle(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH * 2 + ROAD_WIDTH, SQUARE_WIDTH);
+		break;
+
+	case Size::QUAD_SQUARE:
+		drawColor.DrawRectangle(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH * 2 + ROAD_WIDTH, SQUARE_WIDTH * 2 + ROAD_WIDTH);
+		break;
+
+	default:
+		// EXCEPTION MISSING
+		return;
+	}
+}
+
+// Select the texture matching the type of the building
+const raylib::Texture2D* MapRenderer::GetBuildingTexture(const Building& building) const
+{
+	switch (building.GetAreaType())
+	{
+	case AreaType::RESIDENTIAL_AREA:
+		return &houseTexture;
+	case AreaType::HOSPITAL:
+		return &hospitalTexture;
+	case AreaType::SHOPPING_AREA:
+		return &shopTexture;
+	case AreaType::WORKPLACE_AREA:
+		return &workplaceTexture;
+	default:
+		return nullptr;
+	}
+}
+
+// Draw the buildings on visible squares of the map
+void MapRenderer::DrawBuildings(const Map& map, const Rectangle& view) const
+{
+	int squareWidth = map.GetSquareWidth();
+	const std::vector<std::unique_ptr<Building>>& buildingsList = map.GetBuildingsList();
+
+	Vector2i firstSquare, lastSquare;
+	if (!GetVisibleSquares(map, view, firstSquare, lastSquare))
+		return;
+
+	for (int y = firstSquare.y; y <= lastSquare.y; y++)
+	{
+		for (int x = firstSquare.x; x <= lastSquare.x; x++)
+		{
+			int buildingIndex = map.GetBuildingIndexAt({ x, y });
+			if (buildingIndex < 0)
+				continue;
+
+			const Building& building = *buildingsList[buildingIndex];
+			const raylib::Texture2D* texture = GetBuildingTexture(building);
+			if (!texture)
+				continue;
+
+			Vector2i originPosition = building.GetOriginPosition();
+			raylib::Rectangle sourceRectangle(0, 0, (float)texture->GetWidth(), (float)texture->GetHeight());
+			raylib::Rectangle destinationRectangle((float)originPosition.x, (float)originPosition.y, (float)squareWidth, (float)squareWidth);
+			Vector2 origin = { 0, 0 };
+			texture->Draw(sourceRectangle, destinationRectangle, origin, 0.0f, raylib::Color::White());
+		}
+	}
+}
\ No newline at end of file
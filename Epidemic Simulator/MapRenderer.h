@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include "raylib-cpp.hpp"
+#include "Map.h"
+
+const int MAP_TILE_TEXTURE_SIZE = 512;      // Width in pixels of the render texture of a map tile
+const int MAX_MAP_TILES = 64;               // Tiles kept in memory, the least recently drawn ones are replaced first
+const int MAX_MAP_TILE_BAKES_PER_FRAME = 4;
+const float MIN_MAP_TILE_SCALE = 1.0f / 16.0f;
+
+// Part of the map baked into a render texture
+struct MapTile
+{
+    Vector2i position;      // Column and row of the tile
+    raylib::RenderTexture texture;
+    unsigned long long lastUsedFrame;
+};
+
+// Draws the map and its buildings, owns the textures of the buildings.
+// The map does not change after it is generated, so in cached mode it is baked into square tiles of render textures
+// and every frame just draws the visible tiles. Tiles are baked at the power of two scale nearest above the camera zoom
+// and baked again when the map is regenerated or the zoom crosses to another power of two. Until a visible tile is baked,
+// its part of the map is drawn block by block.
+class MapRenderer
+{
+private:
+    const raylib::Color BACKGROUND_COLOR = raylib::Color(85, 85, 85);
+    const raylib::Color GREEN_AREA_COLOR = raylib::Color(52, 166, 77);
+    const raylib::Color RESIDENTIAL_AREA_COLOR = raylib::Color(164, 164, 164);
+    const raylib::Color HOSPITAL_AREA_COLOR = raylib::Color(187, 81, 104);
+    const raylib::Color SHOPPING_AREA_COLOR = raylib::Color(224, 154, 93);
+    const raylib::Color WORKPLACE_AREA_COLOR = raylib::Color(141, 162, 255);
+
+    raylib::Texture2D houseTexture;
+    raylib::Texture2D shopTexture;
+    raylib::Texture2D hospitalTexture;
+    raylib::Texture2D workplaceTexture;
+
+    // Tile cache
+    bool cached;
+    std::vector<MapTile> tiles;
+    const Map* tilesMap;                // Map the tiles were baked from
+    unsigned int tilesMapGeneration;
+    float tileScale;                    // Size of a map pixel in tile texture pixels
+    unsigned long long frame;
+
+    const raylib::Texture2D* GetBuildingTexture(const Building& building) const;
+    bool GetVisibleSquares(const Map& map, const Rectangle& view, Vector2i& firstSquare, Vector2i& lastSquare) const;
+    bool GetVisibleTiles(const Map& map, const Rectangle& view, Vector2i& firstTile, Vector2i& lastTile) const;
+    float GetTileWorldSize() const { return MAP_TILE_TEXTURE_SIZE / tileScale; }
+    const MapTile* FindTile(Vector2i position) const;
+    void BakeTile(const Map& map, Vector2i position);
+    void DrawBlocks(const Map& map, const Rectangle& view) const;
+    void DrawBlock(const Map& map, const MapBlock& block) const;
+    void DrawBuildings(const Map& map, const Rectangle& view) const;
+
+public:
+    MapRenderer();
+
+    // Bake the tiles needed for the view that are not cached yet. Must be called outside of BeginMode2D/EndMode2D
+    void UpdateTiles(const Map& map, const Rectangle& view, float cameraZoom);
+    void ClearTiles() { tiles.clear(); }
+
+    // Only the blocks and buildings overlapping the view (the part of the world seen by the camera) are drawn
+    void DrawMap(const Map& map, const Rectangle& view) const;
+    void SetCached(bool isCached) { cached = isCached; }
+    bool IsCached() const { return cached; }
+};
\ No newline at end of file
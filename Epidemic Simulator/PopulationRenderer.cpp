@@ -0,0 +1,131 @@
+#include "PopulationRenderer.h"
+#include "rlgl.h"
+#include <numeric>
+
+// Colours of people in order of the PersonState values
+const raylib::Color STATE_COLORS[PERSON_STATE_COUNT] = { HEALTHY_COLOR, INFECTED_COLOR, IMMUNE_COLOR, DEAD_COLOR, EXPOSED_COLOR };
+
+PopulationRenderer::PopulationRenderer() : batched(true), gridTick(0), gridPopulation(nullptr)
+{
+    raylib::Image circleImage(CIRCLE_TEXTURE_SIZE, CIRCLE_TEXTURE_SIZE, BLANK);
+    circleImage.DrawCircle(CIRCLE_TEXTURE_SIZE / 2, CIRCLE_TEXTURE_SIZE / 2, CIRCLE_TEXTURE_SIZE / 2 - 1, WHITE);
+    circleTexture.Load(circleImage);
+    circleTexture.GenMipmaps();
+    circleTexture.SetFilter(TEXTURE_FILTER_TRILINEAR);
+}
+
+void PopulationRenderer::DrawPopulation(const Population& population, float cameraZoom, const Rectangle& view)
+{
+    if (batched) {
+        DrawBatched(population, cameraZoom, view);
+        return;
+    }
+
+    ForEachVisiblePerson(population, view, [&](int index) {
+        DrawPerson(population.GetPerson(index));
+    });
+}
+
+// Sort people into grid cells of a few map squares. Positions only change on simulation ticks,
+// so the grid is rebuilt at most once per tick
+void PopulationRenderer::UpdatePeopleGrid(const Population& population)
+{
+    const PopulationStore& store = population.GetStore();
+    if (gridPopulation == &population && gridTick == store.tick && peopleIndices.size() == store.GetSize())
+        return;
+
+    const Map& map = *store.map;
+    if (gridPopulation != &population || peopleIndices.size() != store.GetSize()) {
+        int mapPixelSize = map.GetMapPixelSize();
+        peopleGrid.Resize({ -mapPixelSize / 2, -mapPixelSize / 2 }, mapPixelSize, PEOPLE_GRID_CELL_SQUARES * (map.GetSquareWidth() + map.GetRoadWidth()));
+        peopleIndices.resize(store.GetSize());
+        std::iota(peopleIndices.begin(), peopleIndices.end(), 0);
+    }
+
+    peopleGrid.Rebuild(store.positions, peopleIndices);
+    gridTick = store.tick;
+    gridPopulation = &population;
+}
+
+// Call function(index) for people that can be seen in the view. People in grid cells on the edge of the view
+// may be just outside of it; they are clipped when drawn. When the whole map is in the view, the grid is skipped
+template <typename Function>
+void PopulationRenderer::ForEachVisiblePerson(const Population& population, const Rectangle& view, Function function)
+{
+    float halfMapPixelSize = population.GetStore().map->GetMapPixelSize() / 2.0f;
+    float viewRight = view.x + view.width;
+    float viewBottom = view.y + view.height;
+
+    if (view.x > halfMapPixelSize + DRAW_RADIUS || view.y > halfMapPixelSize + DRAW_RADIUS
+        || viewRight < -halfMapPixelSize - DRAW_RADIUS || viewBottom < -halfMapPixelSize - DRAW_RADIUS)
+        return;
+
+    if (view.x <= -halfMapPixelSize && view.y <= -halfMapPixelSize && viewRight >= halfMapPixelSize && viewBottom >= halfMapPixelSize) {
+        for (int i = 0; i < population.GetPeopleCount(); ++i)
+            function(i);
+        return;
+    }
+
+    UpdatePeopleGrid(population);
+    Vector2i minPosition = { static_cast<int>(view.x - DRAW_RADIUS), static_cast<int>(view.y - DRAW_RADIUS) };
+    Vector2i maxPosition = { static_cast<int>(viewRight + DRAW_RADIUS), static_cast<int>(viewBottom + DRAW_RADIUS) };
+    peopleGrid.ForEachInRectangle(minPosition, maxPosition, function);
+}
+
+// Write a quad per person straight into the render batch. When people are smaller than a few pixels on screen,
+// they are drawn as untextured squares of a fixed screen size (point sprites) instead of circles
+void PopulationRenderer::DrawBatched(const Population& population, float cameraZoom, const Rectangle& view)
+{
+    const PopulationStore& store = population.GetStore();
+
+    bool drawAsPoints = 2.0f * DRAW_RADIUS * cameraZoom < POINT_SPRITE_SCREEN_SIZE;
+    float halfSize = drawAsPoints ? 0.5f * POINT_SPRITE_SCREEN_SIZE / cameraZoom : DRAW_RADIUS;
+    unsigned int textureId = drawAsPoints ? rlGetTextureIdDefault() : circleTexture.id;
+
+    rlSetTexture(textureId);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    ForEachVisiblePerson(population, view, [&](int i) {
+        const raylib::Color& color = STATE_COLORS[store.states[i]];
+        float x = static_cast<float>(store.positions[i].x);
+        float y = static_cast<float>(store.positions[i].y);
+
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlTexCoord2f(0.0f, 0.0f);
+        rlVertex2f(x - halfSize, y - halfSize);
+        rlTexCoord2f(0.0f, 1.0f);
+        rlVertex2f(x - halfSize, y + halfSize);
+        rlTexCoord2f(1.0f, 1.0f);
+        rlVertex2f(x + halfSize, y + halfSize);
+        rlTexCoord2f(1.0f, 0.0f);
+        rlVertex2f(x + halfSize, y - halfSize);
+    });
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void PopulationRenderer::DrawPerson(const Person& person) const
+{
+    raylib::Color color;
+
+    switch (person.GetState()) {
+    case Healthy:
+        color = HEALTHY_COLOR;
+        break;
+    case Infected:
+        color = INFECTED_COLOR;
+        break;
+    case Immune:
+        color = IMMUNE_COLOR;
+        break;
+    case Dead:
+        color = DEAD_COLOR;
+        break;
+    case Exposed:
+        color = EXPOSED_COLOR;
+        break;
+    }
+
+    Vector2i position = person.GetPosition();
+    DrawCircleV(raylib::Vector2(static_cast<float>(position.x), static_cast<float>(position.y)), DRAW_RADIUS, color);
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include "raylib-cpp.hpp"
+#include "Population.h"
+#include "SpatialGrid.h"
+
+const float DRAW_RADIUS = 10.0f; // Radius for drawing the person
+const float POINT_SPRITE_SCREEN_SIZE = 2.0f; // Size in pixels of people drawn as points when zoomed out
+const int CIRCLE_TEXTURE_SIZE = 64;
+const int PEOPLE_GRID_CELL_SQUARES = 4; // Width in map squares of a cell of the grid used to find visible people
+const raylib::Color HEALTHY_COLOR = GREEN;
+const raylib::Color EXPOSED_COLOR = ORANGE;
+const raylib::Color INFECTED_COLOR = RED;
+const raylib::Color IMMUNE_COLOR = SKYBLUE;
+const raylib::Color DEAD_COLOR = BLACK;
+
+// Draws people of the population as circles coloured by their health state.
+// In batched mode every person is a single textured quad written into raylib's render batch,
+// so the whole population takes a handful of draw calls instead of a triangle fan per person.
+// Only people inside the view (the part of the world seen by the camera) are drawn, found with a uniform grid
+// of their positions that is rebuilt after every simulation tick.
+class PopulationRenderer
+{
+private:
+	raylib::Texture circleTexture; // White disk tinted with the state colour of each person
+	bool batched;
+
+	SpatialGrid peopleGrid;
+	std::vector<int> peopleIndices;	// Indices of all people, inserted into the grid
+	uint32_t gridTick;				// Simulation tick the grid was built for
+	const Population* gridPopulation;
+
+	void UpdatePeopleGrid(const Population& population);
+	template <typename Function>
+	void ForEachVisiblePerson(const Population& population, const Rectangle& view, Function function);
+	void DrawBatched(const Population& population, float cameraZoom, const Rectangle& view);
+
+public:
+	PopulationRenderer(); // Needs an open window
+	void DrawPopulation(const Population& population, float cameraZoom, const Rectangle& view);
+	void DrawPerson(const Person& person) const;
+	void SetBatched(bool isBatched) { batched = isBatched; }
+	bool IsBatched() const { return batched; }
+};
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "ProfilerOverlay.h"
+#include <algorithm>
+
+void ProfilerOverlay::Draw(const Profiler& profiler, int x, int y) const
+{
+    if (!visible)
+        return;
+
+    // The default font is not monospaced, so every column starts at its own position
+    const int columnX[] = { 6, 150, 215, 280, 345, 410 };
+    const char* const columnNames[] = { "phase", "mean ms", "median", "p95", "calls", "histogram" };
+    BACKGROUND_COLOR.DrawRectangle(x, y, columnX[5] + HISTOGRAM_WIDTH + 10, (PROFILE_PHASE_COUNT + 1) * ROW_HEIGHT + 8);
+    for (int column = 0; column < 6; column++)
+        TEXT_COLOR.DrawText(columnNames[column], x + columnX[column], y + 4, FONT_SIZE);
+
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        int rowY = y + 4 + (phase + 1) * ROW_HEIGHT;
+        PhaseStatistics statistics = profiler.GetStatistics(static_cast<ProfilePhase>(phase));
+        TEXT_COLOR.DrawText(PROFILE_PHASE_NAMES[phase], x + columnX[0], rowY, FONT_SIZE);
+        TEXT_COLOR.DrawText(TextFormat("%.2f", statistics.mean), x + columnX[1], rowY, FONT_SIZE);
+        TEXT_COLOR.DrawText(TextFormat("%.2f", statistics.median), x + columnX[2], rowY, FONT_SIZE);
+        TEXT_COLOR.DrawText(TextFormat("%.2f", statistics.percentile95), x + columnX[3], rowY, FONT_SIZE);
+        TEXT_COLOR.DrawText(TextFormat("%d", statistics.callsInLastFrame), x + columnX[4], rowY, FONT_SIZE);
+
+        // Histogram of the frame times, every bar is a bucket scaled to the fullest one
+        const int* histogram = profiler.GetHistogram(static_cast<ProfilePhase>(phase));
+        int highestCount = std::max(1, *std::max_element(histogram, histogram + PROFILE_HISTOGRAM_BUCKETS));
+        float barWidth = static_cast<float>(HISTOGRAM_WIDTH) / PROFILE_HISTOGRAM_BUCKETS;
+        for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; bucket++)
+        {
+            if (histogram[bucket] == 0)
+                continue;
+            float barHeight = std::max(1.0f, static_cast<float>(ROW_HEIGHT - 4) * histogram[bucket] / highestCount);
+            HISTOGRAM_COLOR.DrawRectangle(raylib::Rectangle(x + columnX[5] + bucket * barWidth, rowY + ROW_HEIGHT - 4 - barHeight, std::max(barWidth, 1.0f), barHeight));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include "raylib-cpp.hpp"
+#include "Profiler.h"
+
+// Table of the frame phases drawn over the simulation: mean, median and 95th percentile time per frame
+// of every phase over the profiler's window, with a small histogram of the frame times next to each row
+class ProfilerOverlay
+{
+private:
+    const raylib::Color BACKGROUND_COLOR = raylib::Color(0, 0, 0, 170);
+    const raylib::Color TEXT_COLOR = raylib::Color::RayWhite();
+    const raylib::Color HISTOGRAM_COLOR = raylib::Color(255, 161, 0, 220);
+    static const int ROW_HEIGHT = 18;
+    static const int FONT_SIZE = 16;
+    static const int HISTOGRAM_WIDTH = 120;
+
+    bool visible;
+
+public:
+    ProfilerOverlay() : visible(false) {}
+
+    void Draw(const Profiler& profiler, int x, int y) const;
+    void SetVisible(bool isVisible) { visible = isVisible; }
+    bool IsVisible() const { return visible; }
+};
\ No newline at end of file
@@ -4,7 +4,11 @@
 #include "raylib-cpp.hpp"
 #include "Graph.h"
 #include "Map.h"
+#include "MapRenderer.h"
 #include "Population.h"
+#include "PopulationRenderer.h"
+#include "Profiler.h"
+#include "ProfilerOverlay.h"
 #include "SimulationTime.h"
 #include "DiseaseParameters.h"
 
@@ -21,10 +25,6 @@ int main() {
     SetTargetFPS(60);
     
 
-    // Graph and helper variables
-    int filler{}, frameCounter{};
-    Graph graph(100, 50, 705, 450);
-
     // Camera
     raylib::Vector2 screenCenter = { screenWidth / 2, screenHeight / 2 };
     raylib::Camera2D camera;
@@ -39,14 +39,17 @@ int main() {
     diseaseParameters.deathProbabilityPerHour = 0.005f;
     diseaseParameters.hoursToGetImmune = 24.0f;
     diseaseParameters.hoursToGetSymptoms = 12.0f;
+    diseaseParameters.hoursToGetInfectious = 6.0f;
     float simulationHourTime = 1.0f;
     int populationSize = 500;
     int residentsLimit = 4;
+    const float MAX_TIME_SCALE = 1024.0f; // Fastest fast-forward of the simulation
 
     // Initialize and generate the map
     Map map(populationSize, residentsLimit);
     map.GenerateMap();
     map.GenerateBuildings();
+    MapRenderer mapRenderer;
 
     // Constant disease parameters
     diseaseParameters.infectionRadius = 20.0f;
@@ -56,8 +59,18 @@ int main() {
     // Initialize simulation time object
     SimulationTime simulationTime(simulationHourTime);
 
+    // Graph of the compartment counts
+    Graph graph(100, 50, 705, 450, simulationTime.GetTicksPerHour());
+
     // Initialize the population
-    Population population(populationSize, &map, diseaseParameters, residentsLimit);
+    Population population(populationSize, &map, diseaseParameters, residentsLimit, std::random_device{}());
+    population.SetThreadCount(0);
+    PopulationRenderer populationRenderer;
+
+    // Time of the phases of every frame, shown with P and traced with T
+    Profiler& profiler = GetProfiler();
+    profiler.EnableOnThisThread();
+    ProfilerOverlay profilerOverlay;
  
     //--------------------------------------------------------------------------------------
 
@@ -72,24 +85,15 @@ int main() {
                 simulationTime.ChangeHourLength(simulationHourTime);
                 population.ChangePopulationParameters(&diseaseParameters);
 
-                population.UpdateSimulationSpeed(simulationTime.GetHourLength());
+                population.SetTicksPerHour(simulationTime.GetTicksPerHour());
 
                 currentscreen = SIMULATION;
             } break;
             case SIMULATION: {
                 // ----- Graph handling -----
-                // phase 1: initial fill-in
-                if (filler < graph.getWidth() - graph.getAxisWidth()) {
-                    graph.updateGraphStart(&filler, simulationTime.GetHourLength(), &population);
-                }
-                else {
-                    graph.updateGraph(&frameCounter, simulationTime.GetHourLength(), &population);
-                }
-                // reset frameCounter for counting hours in TimeUnits
-                if (frameCounter == trunc(ceil(simulationTime.GetHourLength() * 60.f)) * 24) {
-                    frameCounter = 0;
-                }
-                frameCounter++;
+                // Switch between recent hours and the whole simulation
+                if (IsKeyPressed(KEY_H))
+                    graph.toggleHistoryView();
 
                 // ----- Camera handling -----
                 float wheel = GetMouseWheelMove();
@@ -114,18 +118,76 @@ int main() {
                     camera.zoom = Clamp(expf(logf(camera.zoom) + scale), 0.3f, 0.9f);
                 }
 
-                // ----- Simulation handling -----
-                float deltaTime = GetFrameTime();
+                // Switch between the brute force, spatial grid and building occupancy infection passes (for comparing them)
+                if (IsKeyPressed(KEY_G))
+                {
+                    population.SetInfectionMethod(static_cast<InfectionMethod>((population.GetInfectionMethod() + 1) % INFECTION_METHOD_COUNT));
+                    std::cout << "Infection method: " << GetInfectionMethodName(population.GetInfectionMethod()) << std::endl;
+                }
+
+                // Switch between batched and per-person drawing of people (for comparing frame times)
+                if (IsKeyPressed(KEY_B))
+                {
+                    populationRenderer.SetBatched(!populationRenderer.IsBatched());
+                    std::cout << "People drawing: " << (populationRenderer.IsBatched() ? "batched" : "per person") << std::endl;
+                }
+
+                // Switch between the map baked into tiles and drawing it block by block (for comparing frame times)
+                if (IsKeyPressed(KEY_M))
+                {
+                    mapRenderer.SetCached(!mapRenderer.IsCached());
+                    std::cout << "Map drawing: " << (mapRenderer.IsCached() ? "cached tiles" : "block by block") << std::endl;
+                }
+
+                // Show the time of the phases of a frame
+                if (IsKeyPressed(KEY_P))
+                    profilerOverlay.SetVisible(!profilerOverlay.IsVisible());
 
-                // Update global simulation time and population's current buildings based on schedules
-                simulationTime.AdvanceTime(deltaTime);
+                // Start recording a trace of the phases, and write it for chrome://tracing when pressed again
+                if (IsKeyPressed(KEY_T))
+                {
+                    if (!profiler.IsTracing()) {
+                        profiler.StartTrace();
+                        std::cout << "Trace started" << std::endl;
+                    }
+                    else {
+                        profiler.StopTrace();
+                        try {
+                            profiler.WriteChromeTrace("trace.json");
+                            std::cout << "Trace of " << profiler.GetTraceEventCount() << " events written to trace.json" << std::endl;
+                        }
+                        catch (const std::exception& exception) {
+                            std::cout << exception.what() << std::endl;
+                        }
+                    }
+                }
 
-                if (simulationTime.HasHourChanged()) {
-                    population.UpdatePopulationOnHour(simulationTime.GetHour());
-                    std::cout << "Current hour: " << simulationTime.GetHour() << std::endl;
+                // Fast-forward (right arrow) and slow down (left arrow) the simulation
+                if (IsKeyPressed(KEY_RIGHT))
+                    simulationTime.SetTimeScale(std::min(simulationTime.GetTimeScale() * 2.0f, MAX_TIME_SCALE));
+                if (IsKeyPressed(KEY_LEFT))
+                    simulationTime.SetTimeScale(std::max(simulationTime.GetTimeScale() * 0.5f, 1.0f));
+
+                // ----- Simulation handling -----
+                // Run as many fixed ticks as the frame time is worth, independently of the frame rate
+                int ticks;
+                {
+                    PROFILE_SCOPE(PHASE_ADVANCE_TIME);
+                    ticks = simulationTime.AdvanceTime(GetFrameTime());
                 }
 
-                population.UpdatePopulationOnFrame(deltaTime);
+                for (int tick = 0; tick < ticks; tick++) {
+                    // Update global simulation time and population's current buildings based on schedules
+                    simulationTime.AdvanceTick();
+
+                    if (simulationTime.HasHourChanged())
+                        population.UpdatePopulationOnHour(simulationTime.GetHour());
+
+                    population.UpdatePopulationOnTick();
+
+                    PROFILE_SCOPE(PHASE_GRAPH_UPDATE);
+                    graph.addSample(population.GetCompartmentCounts());
+                }
             } break;
         }
 
@@ -153,33 +215,55 @@ int main() {
                     // background
                     window.ClearBackground(raylib::Color::RayWhite());
 
+                    // Part of the world seen by the camera, everything outside of it is skipped when drawing
+                    raylib::Vector2 viewTopLeft = GetScreenToWorld2D(raylib::Vector2(0, 0), camera);
+                    raylib::Vector2 viewBottomRight = GetScreenToWorld2D(raylib::Vector2(screenWidth, screenHeight), camera);
+                    raylib::Rectangle view(viewTopLeft, viewBottomRight - viewTopLeft);
+                    {
+                        PROFILE_SCOPE(PHASE_DRAW_MAP);
+                        mapRenderer.UpdateTiles(map, view, camera.zoom);
+                    }
+
                     // map
                     BeginMode2D(camera); 
                     {
-                        map.DrawMap();
-                        map.DrawBuildings();
-                        population.DrawPopulation();
+                        {
+                            PROFILE_SCOPE(PHASE_DRAW_MAP);
+                            mapRenderer.DrawMap(map, view);
+                        }
+                        population.UpdatePositions();
+                        PROFILE_SCOPE(PHASE_DRAW_PEOPLE);
+                        populationRenderer.DrawPopulation(population, camera.zoom, view);
                     }
                     EndMode2D();
 
                     // stats section
-                    raylib::Color(0, 0, 0, 150).DrawRectangle(200, screenHeight - 350, 450, 320);
-                    raylib::Color::RayWhite().DrawText("Day: " + std::to_string(simulationTime.GetDay()), 225, screenHeight - 330, 40);
-                    raylib::Color::RayWhite().DrawText("Hour: " + std::to_string(simulationTime.GetHour()), 225, screenHeight - 280, 40);
-                    raylib::Color::Green().DrawText("Healthy: " + std::to_string(population.GetHealthyCount()), 225, screenHeight - 230, 40);
-                    raylib::Color::Red().DrawText("Infected: " + std::to_string(population.GetInfectedCount()), 225, screenHeight - 180, 40);
-                    raylib::Color::SkyBlue().DrawText("Immune: " + std::to_string(population.GetImmuneCount()), 225, screenHeight - 130, 40);
-                    raylib::Color::Black().DrawText("Dead: " + std::to_string(population.GetDeadCount()), 225, screenHeight - 80, 40);
+                    PROFILE_SCOPE(PHASE_DRAW_INTERFACE);
+                    raylib::Color(0, 0, 0, 150).DrawRectangle(200, screenHeight - 400, 450, 370);
+                    raylib::Color::RayWhite().DrawText("Day: " + std::to_string(simulationTime.GetDay()), 225, screenHeight - 380, 40);
+                    raylib::Color::RayWhite().DrawText("Hour: " + std::to_string(simulationTime.GetHour()), 225, screenHeight - 330, 40);
+                    raylib::Color::RayWhite().DrawText(TextFormat("x%.0f", simulationTime.GetTimeScale()), 500, screenHeight - 380, 40);
+                    CompartmentCounts counts = population.GetCompartmentCounts();
+                    raylib::Color::Green().DrawText("Healthy: " + std::to_string(counts.healthy), 225, screenHeight - 280, 40);
+                    raylib::Color::Orange().DrawText("Exposed: " + std::to_string(counts.exposed), 225, screenHeight - 230, 40);
+                    raylib::Color::Red().DrawText("Infected: " + std::to_string(counts.infected), 225, screenHeight - 180, 40);
+                    raylib::Color::SkyBlue().DrawText("Immune: " + std::to_string(counts.immune), 225, screenHeight - 130, 40);
+                    raylib::Color::Black().DrawText("Dead: " + std::to_string(counts.dead), 225, screenHeight - 80, 40);
 
                     // window & graph
                     window.DrawFPS();
+                    raylib::Color::DarkGreen().DrawText(TextFormat("%.2f ms", GetFrameTime() * 1000.0f), 10, 35, 20);
                     graph.drawGraph();
-                    
+                    profilerOverlay.Draw(profiler, 10, 60);
 
                 } break;
             }
         }
-        window.EndDrawing();
+        {
+            PROFILE_SCOPE(PHASE_PRESENT);
+            window.EndDrawing();
+        }
+        profiler.EndFrame();
         //----------------------------------------------------------------------------------
     }
     return 0;
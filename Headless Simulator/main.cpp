@@ -0,0 +1,516 @@
+#include "Checkpoint.h"
+#include "Ensemble.h"
+#include "ParameterSweep.h"
+#include "Profiler.h"
+#include "Map.h"
+#include "MetricsSink.h"
+#include "Population.h"
+#include "SimulationTime.h"
+#include "DiseaseParameters.h"
+#include "DiseaseModel.h"
+#include "Random.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Headless simulation: runs the model for a number of simulated days without rendering and prints the final counts
+//
+// Usage: "Headless Simulator" [--days N] [--population N] [--seed N] [--threads N] [--ticks-per-hour N] [--brute-force | --building-occupancy] [--benchmark-startup]
+//                              [--load-checkpoint FILE] [--save-checkpoint FILE] [--checkpoint-every DAYS]
+//                              [--metrics PREFIX] [--metrics-format csv|binary] [--metrics-buildings] [--benchmark-metrics]
+//                              [--ensemble REPLICATES] [--ensemble-output FILE]
+//                              [--sweep PARAMETER=MIN:MAX[:STEPS]]... [--sweep-lhs SAMPLES] [--sweep-cities N] [--sweep-output FILE]
+//                              [--profile] [--trace FILE] [--contact-kernel scalar|sse2|avx2] [--disease-model sir-d|seir]
+//
+// --brute-force tests every pair of people for contacts, --building-occupancy counts the infectious people inside every building
+// and tests only the people on the streets (the uniform grid is used by default).
+// A run restored with --load-checkpoint continues from the saved state until the end of day N (map, population and seed come from the file).
+// --ticks-per-hour, --brute-force, --building-occupancy and --disease-model given with it replace the saved settings, so other scenarios
+// can continue from the same state.
+// --save-checkpoint saves the state when the run ends, and also at the start of every DAYS-th day with --checkpoint-every.
+// --metrics streams the counts of every tick and hour (and of people in every building with --metrics-buildings) into PREFIX_*.csv/bin files
+// instead of printing them.
+// --ensemble runs REPLICATES independent simulations on one map with seeds seed, seed + 1, ..., using --threads threads (all by default),
+// prints daily quantiles of the counts over the replicates and writes hourly quantiles to FILE with --ensemble-output.
+// --sweep runs the simulation for a grid of values (STEPS of them, 1 by default) of every given field of DiseaseParameters
+// (e.g. infectionProbabilityPerHour=0.005:0.05:10), or for SAMPLES Latin hypercube samples of the ranges with --sweep-lhs,
+// on N cities with seeds seed, seed + 1, ... and writes the peak, the time to peak and the deaths of every run to FILE (sweep.csv).
+// --profile prints how the time of a tick splits between the phases of the model, --trace also writes them as a Chrome trace to FILE.
+// --contact-kernel replaces the fastest contact count the processor supports with the given one (the results are the same).
+// --disease-model seir makes infected people exposed (not infectious) for hoursToGetInfectious hours first (sir-d by default).
+
+void PrintUsage()
+{
+    std::cout << "Usage: \"Headless Simulator\" [--days N] [--population N] [--seed N] [--threads N] [--ticks-per-hour N] [--brute-force | --building-occupancy] [--benchmark-startup]"
+        << " [--load-checkpoint FILE] [--save-checkpoint FILE] [--checkpoint-every DAYS]"
+        << " [--metrics PREFIX] [--metrics-format csv|binary] [--metrics-buildings] [--benchmark-metrics]"
+        << " [--ensemble REPLICATES] [--ensemble-output FILE]"
+        << " [--sweep PARAMETER=MIN:MAX[:STEPS]]... [--sweep-lhs SAMPLES] [--sweep-cities N] [--sweep-output FILE]"
+        << " [--profile] [--trace FILE] [--contact-kernel scalar|sse2|avx2] [--disease-model sir-d|seir]" << std::endl;
+}
+
+ContactKernelType ParseContactKernel(const std::string& name)
+{
+    for (int type = 0; type < CONTACT_KERNEL_TYPE_COUNT; type++) {
+        if (name == GetContactKernelName(static_cast<ContactKernelType>(type)))
+            return static_cast<ContactKernelType>(type);
+    }
+    throw std::invalid_argument("Unknown contact kernel " + name);
+}
+
+DiseaseModelType ParseDiseaseModel(const std::string& name)
+{
+    for (int type = 0; type < DISEASE_MODEL_TYPE_COUNT; type++) {
+        if (name == GetDiseaseModelName(static_cast<DiseaseModelType>(type)))
+            return static_cast<DiseaseModelType>(type);
+    }
+    throw std::invalid_argument("Unknown disease model " + name);
+}
+
+void SaveCheckpoint(const std::string& path, const Map& map, const Population& population, const SimulationTime& simulationTime)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    Checkpoint::Save(path, map, population, simulationTime);
+    std::chrono::duration<double, std::milli> saveTime = std::chrono::steady_clock::now() - startTime;
+    std::cout << "Checkpoint of day " << simulationTime.GetDay() << " saved to " << path << " in " << saveTime.count() << " ms" << std::endl;
+}
+
+// Time generation of the map and construction of the population for growing population sizes
+void RunStartupBenchmark(const DiseaseParameters& diseaseParameters, int residentsLimit, unsigned int seed)
+{
+    for (int populationSize : { 10000, 100000, 1000000 }) {
+        SetRandomSeed(seed);
+        auto startTime = std::chrono::steady_clock::now();
+        Map map(populationSize, residentsLimit);
+        map.GenerateMap();
+        map.GenerateBuildings();
+        auto mapTime = std::chrono::steady_clock::now();
+        Population population(populationSize, &map, diseaseParameters, residentsLimit, seed);
+        auto populationTime = std::chrono::steady_clock::now();
+
+        std::chrono::duration<double, std::milli> mapDuration = mapTime - startTime;
+        std::chrono::duration<double, std::milli> populationDuration = populationTime - mapTime;
+        std::cout << populationSize << " people: map of " << map.GetMapWidth() << "x" << map.GetMapWidth() << " squares in " << mapDuration.count()
+            << " ms (routing table " << map.GetRoutingTable().GetBuildTime() * 1000.0 << " ms), population in " << populationDuration.count() << " ms" << std::endl;
+    }
+}
+
+// Ways of reporting the counts compared by the metrics benchmark
+enum MetricsOutput { NO_OUTPUT, CONSOLE_HOURLY, CONSOLE_EVERY_TICK, SINK_CSV, SINK_BINARY, SINK_BINARY_WITH_BUILDINGS, METRICS_OUTPUT_COUNT };
+const char* const METRICS_OUTPUT_NAMES[METRICS_OUTPUT_COUNT] = {
+    "no output", "console, every hour", "console, every tick", "metrics sink, csv", "metrics sink, binary", "metrics sink, binary with buildings"
+};
+
+void PrintCounts(const char* label, long long value, const CompartmentCounts& counts)
+{
+    std::cout << label << value << ": Healthy: " << counts.healthy << ", Exposed: " << counts.exposed << ", Infected: " << counts.infected
+        << ", Immune: " << counts.immune << ", Dead: " << counts.dead << std::endl;
+}
+
+// Time the same simulation with every way of reporting the counts, both in total and only the time spent reporting
+// (the simulation itself is the same for all of them). Console output goes to stdout, so it can be redirected
+// to a terminal or a file, and the results are printed to stderr
+void RunMetricsBenchmark(const DiseaseParameters& diseaseParameters, int residentsLimit, unsigned int seed, int populationSize, int days)
+{
+    for (int output = 0; output < METRICS_OUTPUT_COUNT; output++) {
+        SetRandomSeed(seed);
+        Map map(populationSize, residentsLimit);
+        map.GenerateMap();
+        map.GenerateBuildings();
+        Population population(populationSize, &map, diseaseParameters, residentsLimit, seed);
+        population.ChangePopulationParameters(&diseaseParameters);
+        SimulationTime simulationTime;
+        population.SetTicksPerHour(simulationTime.GetTicksPerHour());
+        std::vector<CompartmentCounts> buildingCounts;
+        std::chrono::duration<double> reportingTime(0.0);
+        unsigned long long producerWaits = 0;
+
+        auto startTime = std::chrono::steady_clock::now();
+        std::unique_ptr<MetricsSink> sink;
+        if (output >= SINK_CSV)
+            sink = std::make_unique<MetricsSink>("metrics_benchmark", output == SINK_CSV ? MetricsCsv : MetricsBinary);
+
+        while (simulationTime.GetDay() <= days) {
+            simulationTime.AdvanceTick();
+
+            if (simulationTime.HasHourChanged()) {
+                population.UpdatePopulationOnHour(simulationTime.GetHour());
+
+                auto reportingStart = std::chrono::steady_clock::now();
+                uint32_t tick = population.GetStore().tick;
+                if (output == CONSOLE_HOURLY || output == CONSOLE_EVERY_TICK)
+                    PrintCounts("Hour ", simulationTime.GetHour(), population.GetCompartmentCounts());
+                else if (sink)
+                    sink->RecordHour(tick, simulationTime.GetDay(), simulationTime.GetHour(), population.GetCompartmentCounts());
+                if (output == SINK_BINARY_WITH_BUILDINGS) {
+                    population.UpdatePositions();
+                    population.GetStore().CountPeopleInBuildings(buildingCounts);
+                    sink->RecordBuildings(tick, buildingCounts);
+                }
+                reportingTime += std::chrono::steady_clock::now() - reportingStart;
+            }
+
+            population.UpdatePopulationOnTick();
+
+            auto reportingStart = std::chrono::steady_clock::now();
+            if (output == CONSOLE_EVERY_TICK)
+                PrintCounts("Tick ", population.GetStore().tick, population.GetCompartmentCounts());
+            else if (sink)
+                sink->RecordTick(population.GetStore().tick, population.GetCompartmentCounts());
+            reportingTime += std::chrono::steady_clock::now() - reportingStart;
+        }
+
+        // Writing the rest of the rows counts too
+        auto reportingStart = std::chrono::steady_clock::now();
+        if (sink) {
+            sink->Flush();
+            producerWaits = sink->GetProducerWaits();
+            sink.reset();
+        }
+        reportingTime += std::chrono::steady_clock::now() - reportingStart;
+        std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+        std::cerr << METRICS_OUTPUT_NAMES[output] << ": " << elapsedTime.count() << " s in total, " << reportingTime.count() * 1000.0
+            << " ms reporting (" << producerWaits << " waits for the writer)" << std::endl;
+    }
+
+    for (const char* file : { "metrics_benchmark_ticks.bin", "metrics_benchmark_hours.bin", "metrics_benchmark_buildings.bin",
+        "metrics_benchmark_ticks.csv", "metrics_benchmark_hours.csv", "metrics_benchmark_buildings.csv" })
+        std::remove(file);
+}
+
+// Run an ensemble of replicates on one map and print the spread of their results
+void RunEnsemble(const EnsembleSettings& settings, int threadCount, const std::string& outputPath)
+{
+    SetRandomSeed(static_cast<unsigned int>(settings.firstSeed));
+    Map map(settings.run.populationSize, settings.run.residentsInBuildingLimit);
+    map.GenerateMap();
+    map.GenerateBuildings();
+
+    Ensemble ensemble(map, settings);
+    ensemble.Run(threadCount);
+
+    // Quantiles at midnight of every day
+    std::cout << "Day: median [5%, 95%] of exposed | infected | dead" << std::endl;
+    for (int day = 1; day <= settings.run.days; day++) {
+        int hour = day * 24 - 1;
+        CompartmentCounts low = ensemble.GetQuantile(hour, 0.05f);
+        CompartmentCounts median = ensemble.GetQuantile(hour, 0.5f);
+        CompartmentCounts high = ensemble.GetQuantile(hour, 0.95f);
+        std::cout << "Day " << day << ": " << median.exposed << " [" << low.exposed << ", " << high.exposed << "] | " << median.infected << " [" << low.infected << ", " << high.infected << "] | "
+            << median.dead << " [" << low.dead << ", " << high.dead << "]" << std::endl;
+    }
+
+    std::cout << "Simulated " << settings.replicateCount << " replicates of " << settings.run.days << " days of " << settings.run.populationSize << " people in "
+        << ensemble.GetRunTime() << " s: " << ensemble.GetReplicatesPerSecond() << " replicates/s (" << ensemble.GetThreadCount() << " threads, "
+        << ensemble.GetSteals() << " replicates stolen)" << std::endl;
+
+    if (!outputPath.empty())
+        ensemble.WriteQuantiles(outputPath, { 0.05f, 0.25f, 0.5f, 0.75f, 0.95f });
+}
+
+// Read a dimension of a sweep written as PARAMETER=MIN:MAX[:STEPS], throws if it is invalid
+SweepDimension ParseSweepDimension(const std::string& text)
+{
+    size_t equals = text.find('=');
+    size_t firstColon = text.find(':', equals);
+    size_t secondColon = text.find(':', firstColon + 1);
+    if (equals == std::string::npos || firstColon == std::string::npos)
+        throw std::invalid_argument("Sweep dimension must be PARAMETER=MIN:MAX[:STEPS]");
+
+    SweepDimension dimension;
+    dimension.name = text.substr(0, equals);
+    dimension.field = ParameterSweep::FindParameter(dimension.name);
+    if (!dimension.field)
+        throw std::invalid_argument("Unknown disease parameter " + dimension.name);
+    dimension.min = std::stof(text.substr(equals + 1, firstColon - equals - 1));
+    dimension.max = std::stof(text.substr(firstColon + 1, secondColon - firstColon - 1));
+    dimension.steps = secondColon == std::string::npos ? 1 : std::stoi(text.substr(secondColon + 1));
+    return dimension;
+}
+
+// Run every point of a sweep on every city and write the summary of every run
+void RunSweep(const SweepSettings& settings, int threadCount, const std::string& outputPath)
+{
+    ParameterSweep sweep(settings);
+    sweep.Run(threadCount);
+    sweep.WriteResults(outputPath);
+
+    std::cout << "Generated " << settings.citySeeds.size() << " maps in " << sweep.GetMapGenerationTime() * 1000.0 << " ms" << std::endl;
+    std::cout << "Simulated " << sweep.GetRunCount() << " runs (" << sweep.GetPoints().size() << " points on " << settings.citySeeds.size() << " cities) of "
+        << settings.run.days << " days of " << settings.run.populationSize << " people in " << sweep.GetRunTime() << " s: "
+        << sweep.GetRunsPerHour() << " runs/hour (" << sweep.GetThreadCount() << " threads)" << std::endl;
+    std::cout << "Results written to " << outputPath << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Simulation settings (the same defaults as in the windowed application)
+    int days = 30;
+    int populationSize = 500;
+    int residentsLimit = 4;
+    float simulationHourTime = 1.0f;
+    unsigned int seed = std::random_device{}();
+    int threadCount = 0;
+    int ticksPerHour = DEFAULT_TICKS_PER_HOUR;
+    InfectionMethod infectionMethod = UniformGrid;
+    bool ticksPerHourGiven = false;     // Settings given on the command line replace the ones of a loaded checkpoint
+    bool infectionMethodGiven = false;
+    bool diseaseModelGiven = false;
+    bool benchmarkStartup = false;
+    std::string loadCheckpointPath;
+    std::string saveCheckpointPath;
+    int checkpointEveryDays = 0;
+    std::string metricsPrefix;
+    MetricsFormat metricsFormat = MetricsCsv;
+    bool metricsBuildings = false;
+    bool benchmarkMetrics = false;
+    int ensembleReplicates = 0;
+    std::string ensembleOutputPath;
+    std::vector<SweepDimension> sweepDimensions;
+    int sweepSamples = 0;
+    int sweepCities = 1;
+    std::string sweepOutputPath = "sweep.csv";
+    bool profile = false;
+    std::string tracePath;
+    ContactKernelType contactKernel = GetFastestContactKernel();
+    DiseaseModelType diseaseModel = SIRD_MODEL;
+
+    DiseaseParameters diseaseParameters;
+    diseaseParameters.infectionProbabilityPerHour = 0.05f;
+    diseaseParameters.deathProbabilityPerHour = 0.005f;
+    diseaseParameters.hoursToGetImmune = 24.0f;
+    diseaseParameters.hoursToGetSymptoms = 12.0f;
+    diseaseParameters.infectionRadius = 20.0f;
+    diseaseParameters.probabilityOfGoingToHospitalPerHour = 0.01f;
+    diseaseParameters.deathProbabilityPerHourInHospital = 0.002f;
+    diseaseParameters.hoursToGetInfectious = 6.0f;
+
+    // Read command line arguments
+    try {
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--days") == 0 && i + 1 < argc)
+                days = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--population") == 0 && i + 1 < argc)
+                populationSize = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+                seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                threadCount = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--ticks-per-hour") == 0 && i + 1 < argc)
+                ticksPerHour = std::stoi(argv[++i]), ticksPerHourGiven = true;
+            else if (std::strcmp(argv[i], "--brute-force") == 0)
+                infectionMethod = BruteForce, infectionMethodGiven = true;
+            else if (std::strcmp(argv[i], "--building-occupancy") == 0)
+                infectionMethod = BuildingOccupancy, infectionMethodGiven = true;
+            else if (std::strcmp(argv[i], "--benchmark-startup") == 0)
+                benchmarkStartup = true;
+            else if (std::strcmp(argv[i], "--load-checkpoint") == 0 && i + 1 < argc)
+                loadCheckpointPath = argv[++i];
+            else if (std::strcmp(argv[i], "--save-checkpoint") == 0 && i + 1 < argc)
+                saveCheckpointPath = argv[++i];
+            else if (std::strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc)
+                checkpointEveryDays = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--metrics") == 0 && i + 1 < argc)
+                metricsPrefix = argv[++i];
+            else if (std::strcmp(argv[i], "--metrics-format") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "csv") == 0)
+                metricsFormat = MetricsCsv, i++;
+            else if (std::strcmp(argv[i], "--metrics-format") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "binary") == 0)
+                metricsFormat = MetricsBinary, i++;
+            else if (std::strcmp(argv[i], "--metrics-buildings") == 0)
+                metricsBuildings = true;
+            else if (std::strcmp(argv[i], "--benchmark-metrics") == 0)
+                benchmarkMetrics = true;
+            else if (std::strcmp(argv[i], "--ensemble") == 0 && i + 1 < argc)
+                ensembleReplicates = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--ensemble-output") == 0 && i + 1 < argc)
+                ensembleOutputPath = argv[++i];
+            else if (std::strcmp(argv[i], "--sweep") == 0 && i + 1 < argc)
+                sweepDimensions.push_back(ParseSweepDimension(argv[++i]));
+            else if (std::strcmp(argv[i], "--sweep-lhs") == 0 && i + 1 < argc)
+                sweepSamples = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--sweep-cities") == 0 && i + 1 < argc)
+                sweepCities = std::stoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--sweep-output") == 0 && i + 1 < argc)
+                sweepOutputPath = argv[++i];
+            else if (std::strcmp(argv[i], "--profile") == 0)
+                profile = true;
+            else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+                tracePath = argv[++i], profile = true;
+            else if (std::strcmp(argv[i], "--contact-kernel") == 0 && i + 1 < argc)
+                contactKernel = ParseContactKernel(argv[++i]);
+            else if (std::strcmp(argv[i], "--disease-model") == 0 && i + 1 < argc)
+                diseaseModel = ParseDiseaseModel(argv[++i]), diseaseModelGiven = true;
+            else {
+                PrintUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        if (benchmarkStartup) {
+            RunStartupBenchmark(diseaseParameters, residentsLimit, seed);
+            return 0;
+        }
+        if (benchmarkMetrics) {
+            RunMetricsBenchmark(diseaseParameters, residentsLimit, seed, populationSize, days);
+            return 0;
+        }
+        if (ensembleReplicates > 0) {
+            RunSettings runSettings = { days, populationSize, residentsLimit, ticksPerHour, infectionMethod, diseaseParameters, diseaseModel };
+            EnsembleSettings settings = { ensembleReplicates, seed, runSettings };
+            RunEnsemble(settings, threadCount, ensembleOutputPath);
+            return 0;
+        }
+        if (!sweepDimensions.empty()) {
+            SweepSettings settings;
+            settings.dimensions = sweepDimensions;
+            settings.sampling = sweepSamples > 0 ? LatinHypercubeSampling : GridSampling;
+            settings.sampleCount = sweepSamples;
+            settings.samplingSeed = seed;
+            for (int city = 0; city < sweepCities; city++)
+                settings.citySeeds.push_back(seed + city);
+            settings.run = { days, populationSize, residentsLimit, ticksPerHour, infectionMethod, diseaseParameters, diseaseModel };
+            RunSweep(settings, threadCount, sweepOutputPath);
+            return 0;
+        }
+
+        std::unique_ptr<Map> map;
+        std::unique_ptr<Population> population;
+        SimulationTime simulationTime(simulationHourTime, ticksPerHour);
+
+        if (!loadCheckpointPath.empty()) {
+            // Restore the map, the population and the clock saved earlier
+            auto loadStartTime = std::chrono::steady_clock::now();
+            SimulationCheckpoint checkpoint = Checkpoint::Load(loadCheckpointPath);
+            std::chrono::duration<double, std::milli> loadTime = std::chrono::steady_clock::now() - loadStartTime;
+
+            map = std::move(checkpoint.map);
+            population = std::move(checkpoint.population);
+            simulationTime = checkpoint.time;
+            populationSize = population->GetPeopleCount();
+            seed = static_cast<unsigned int>(population->GetStore().randomSeed);
+            std::cout << "Checkpoint of day " << simulationTime.GetDay() << " with " << populationSize << " people loaded from "
+                << loadCheckpointPath << " in " << loadTime.count() << " ms" << std::endl;
+
+            if (ticksPerHourGiven) {
+                simulationTime.SetTicksPerHour(ticksPerHour);
+                population->SetTicksPerHour(ticksPerHour);
+            }
+            if (infectionMethodGiven)
+                population->SetInfectionMethod(infectionMethod);
+            if (diseaseModelGiven)
+                population->SetDiseaseModel(diseaseModel);
+        }
+        else {
+            // Initialize and generate the map
+            SetRandomSeed(seed);
+            auto mapStartTime = std::chrono::steady_clock::now();
+            map = std::make_unique<Map>(populationSize, residentsLimit);
+            map->GenerateMap();
+            std::chrono::duration<double, std::milli> mapGenerationTime = std::chrono::steady_clock::now() - mapStartTime;
+            map->GenerateBuildings();
+
+            const RoutingTable& routingTable = map->GetRoutingTable();
+            std::cout << "Map of " << map->GetMapWidth() << "x" << map->GetMapWidth() << " squares generated in " << mapGenerationTime.count() << " ms" << std::endl;
+            std::cout << "Routing table for " << routingTable.GetDestinationCount()
+                << " destinations: " << routingTable.GetMemoryUsage() / 1024 << " KB built in " << routingTable.GetBuildTime() * 1000.0 << " ms" << std::endl;
+
+            // Initialize the population
+            population = std::make_unique<Population>(populationSize, map.get(), diseaseParameters, residentsLimit, seed);
+            population->SetInfectionMethod(infectionMethod);
+            population->ChangePopulationParameters(&diseaseParameters);
+            population->SetDiseaseModel(diseaseModel);
+            population->SetTicksPerHour(simulationTime.GetTicksPerHour());
+        }
+        population->SetThreadCount(threadCount);
+        population->SetContactKernel(contactKernel);
+
+        // Stream the counts into files instead of printing them
+        std::unique_ptr<MetricsSink> metricsSink;
+        std::vector<CompartmentCounts> buildingCounts;
+        if (!metricsPrefix.empty())
+            metricsSink = std::make_unique<MetricsSink>(metricsPrefix, metricsFormat);
+        population->SetPrintHourlyCounts(!metricsSink);
+
+        // Every tick is a frame of the profiler
+        Profiler& profiler = GetProfiler();
+        if (profile) {
+            profiler.EnableOnThisThread();
+            if (!tracePath.empty())
+                profiler.StartTrace();
+        }
+
+        // Run the simulation tick by tick, as fast as possible
+        auto startTime = std::chrono::steady_clock::now();
+        int startDay = simulationTime.GetDay();
+
+        while (simulationTime.GetDay() <= days) {
+            // Periodic checkpoints are taken between ticks at midnight, where a restored run continues exactly the same way
+            if (!saveCheckpointPath.empty() && checkpointEveryDays > 0 && simulationTime.GetDay() > startDay && simulationTime.GetHour() == 0
+                && simulationTime.GetTickInHour() == 0 && (simulationTime.GetDay() - 1) % checkpointEveryDays == 0)
+                SaveCheckpoint(saveCheckpointPath, *map, *population, simulationTime);
+
+            simulationTime.AdvanceTick();
+
+            if (simulationTime.HasHourChanged()) {
+                population->UpdatePopulationOnHour(simulationTime.GetHour());
+                if (metricsSink) {
+                    uint32_t tick = population->GetStore().tick;
+                    metricsSink->RecordHour(tick, simulationTime.GetDay(), simulationTime.GetHour(), population->GetCompartmentCounts());
+                    if (metricsBuildings) {
+                        population->UpdatePositions();
+                        population->GetStore().CountPeopleInBuildings(buildingCounts);
+                        metricsSink->RecordBuildings(tick, buildingCounts);
+                    }
+                }
+            }
+
+            population->UpdatePopulationOnTick();
+            if (metricsSink)
+                metricsSink->RecordTick(population->GetStore().tick, population->GetCompartmentCounts());
+            if (profile)
+                profiler.EndFrame();
+        }
+        if (metricsSink)
+            metricsSink->Flush();
+
+        std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+        std::cout << "Simulated " << days - startDay + 1 << " days of " << populationSize << " people in " << elapsedTime.count() << " s"
+            << " (seed " << seed << ", " << population->GetThreadCount() << " threads)" << std::endl;
+        if (!saveCheckpointPath.empty())
+            SaveCheckpoint(saveCheckpointPath, *map, *population, simulationTime);
+
+        CompartmentCounts counts = population->GetCompartmentCounts();
+        std::cout << "Healthy: " << counts.healthy << ", Exposed: " << counts.exposed << ", Infected: " << counts.infected
+            << ", Immune: " << counts.immune << ", Dead: " << counts.dead << std::endl;
+
+        if (profile) {
+            double tickTime = profiler.GetTotalTime(PHASE_FRAME);
+            for (ProfilePhase phase : { PHASE_UPDATE_ON_HOUR, PHASE_UPDATE_PEOPLE, PHASE_INFECTION }) {
+                std::cout << PROFILE_PHASE_NAMES[phase] << ": " << profiler.GetTotalTime(phase) << " ms in " << profiler.GetTotalCalls(phase)
+                    << " calls (" << 100.0 * profiler.GetTotalTime(phase) / tickTime << "% of the ticks)" << std::endl;
+            }
+            if (!tracePath.empty()) {
+                profiler.StopTrace();
+                profiler.WriteChromeTrace(tracePath);
+                std::cout << "Trace of " << profiler.GetTraceEventCount() << " events written to " << tracePath << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& exception) {
+        std::cerr << "Simulation failed: " << exception.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Vector2i.h"
+#include "MapBlock.h"
+
+class Building
+{
+protected:
+	Vector2i originPosition;	// the position of the top left corner of the building's square
+	Vector2i position;		// the position of the building at the center
+
+public:
+	Building(int x, int y, int squareWidth) : originPosition(x, y), position({ x + squareWidth / 2, y + squareWidth / 2 }) {}
+	virtual ~Building() = default;
+	virtual AreaType GetAreaType() const = 0;
+	Vector2i GetOriginPosition() const { return originPosition; }
+	Vector2i GetPosition() const { return position; }
+};
+
+
+// Residents, employees and the people inside a building are kept by the population (PopulationStore::houses,
+// workplaceBuildings and currentBuildings), so one map can be shared by many populations
+class House : public Building
+{
+public:
+	House(int x, int y, int squareWidth) : Building(x, y, squareWidth) {}
+	AreaType GetAreaType() const override { return AreaType::RESIDENTIAL_AREA; }
+};
+
+
+class Shop : public Building
+{
+public:
+	Shop(int x, int y, int squareWidth) : Building(x, y, squareWidth) {}
+	AreaType GetAreaType() const override { return AreaType::SHOPPING_AREA; }
+};
+
+
+class Hospital : public Building
+{
+public:
+	Hospital(int x, int y, int squareWidth) : Building(x, y, squareWidth) {}
+	AreaType GetAreaType() const override { return AreaType::HOSPITAL; }
+};
+
+
+class Workplace : public Building
+{
+public:
+	Workplace(int x, int y, int squareWidth) : Building(x, y, squareWidth) {}
+	AreaType GetAreaType() const override { return AreaType::WORKPLACE_AREA; }
+};
\ No newline at end of file
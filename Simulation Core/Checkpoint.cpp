@@ -0,0 +1,549 @@
+#include "Checkpoint.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char CHECKPOINT_MAGIC[8] = { 'E', 'P', 'I', 'D', 'E', 'M', 'I', 'C' };
+const uint32_t CHECKPOINT_BYTE_ORDER_MARK = 0x01020304;	// Read back differently on machines with another byte order
+const size_t CHECKPOINT_ALIGNMENT = 8;
+
+enum CheckpointSectionId : uint32_t
+{
+	SIMULATION_SECTION,
+	MAP_BLOCKS_SECTION,
+	BLOCKED_ROADS_SECTION,
+	ROUTING_SECTION,
+	ROUTING_DESTINATION_FIELDS_SECTION,
+	ROUTING_COMPONENTS_SECTION,
+	ROUTING_FLOW_FIELDS_SECTION,
+	POSITIONS_SECTION,
+	STATES_SECTION,
+	INFECTION_TICKS_SECTION,
+	HOUSES_SECTION,
+	WORKPLACE_BUILDINGS_SECTION,
+	SHOPPING_BUILDINGS_SECTION,
+	CURRENT_BUILDINGS_SECTION,
+	SCHEDULES_SECTION,
+	CURRENT_INTERSECTIONS_SECTION,
+	NEXT_INTERSECTIONS_SECTION,
+	NEXT_INTERSECTION_PIXELS_SECTION,
+	TARGET_INTERSECTIONS_SECTION,
+	REACHED_DESTINATIONS_SECTION,
+	DEPARTURE_TICKS_SECTION,
+	LEG_STARTS_SECTION,
+	LEG_START_DISTANCES_SECTION,
+	CHECKPOINT_SECTION_COUNT
+};
+
+struct CheckpointHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrderMark;
+	uint64_t fileSize;
+	uint32_t sectionCount;
+	uint32_t reserved;
+};
+
+// Entry of the table of sections following the header
+struct CheckpointSection
+{
+	uint32_t id;
+	uint32_t recordSize;
+	uint64_t recordCount;
+	uint64_t offset;	// Position of the first record from the start of the file
+};
+
+// Scalar state of the map, the population and the clock
+struct CheckpointSimulation
+{
+	int32_t mapSquareSize;
+	int32_t residentsInBuildingLimit;
+	uint64_t randomSeed;
+	uint32_t tick;
+	int32_t ticksPerHour;
+	int32_t infectionMethod;
+	int32_t diseaseModel;
+	DiseaseParameters diseaseParameters;	// As used by people (changing the parameters adjusts some of them)
+	double timeAccumulator;
+	float hourLength;
+	float timeScale;
+	int32_t clockTicksPerHour;
+	int32_t maxTicksPerAdvance;
+	int32_t tickInHour;
+	int32_t hour;
+	int32_t day;
+	uint32_t hourChanged;
+};
+
+// Map block given by its base square, the other squares follow from the size
+struct CheckpointBlock
+{
+	int32_t baseX;
+	int32_t baseY;
+	uint8_t size;
+	uint8_t areaType;
+	uint8_t reserved[2];
+};
+
+struct CheckpointRouting
+{
+	int32_t width;
+	int32_t fieldStride;
+	int32_t destinationCount;
+	uint32_t usesFlowFields;
+};
+
+static_assert(sizeof(CheckpointHeader) == 32 && sizeof(CheckpointSection) == 24, "Unexpected layout of checkpoint headers");
+static_assert(sizeof(CheckpointSimulation) == 104 && sizeof(CheckpointBlock) == 12 && sizeof(CheckpointRouting) == 16, "Unexpected layout of checkpoint records");
+static_assert(sizeof(Vector2i) == 8 && sizeof(PersonSchedule) == 4 && sizeof(PersonState) == 1, "Unexpected layout of person records");
+
+// Write the data of a closed file through to the disk, so it survives a crash once the file is renamed
+bool SyncCheckpointFile(const std::string& path)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	bool synced = FlushFileBuffers(file) != 0;
+	CloseHandle(file);
+#else
+	int file = open(path.c_str(), O_WRONLY);
+	if (file < 0)
+		return false;
+	bool synced = fsync(file) == 0;
+	close(file);
+#endif
+	return synced;
+}
+
+size_t AlignCheckpointOffset(size_t offset)
+{
+	return (offset + CHECKPOINT_ALIGNMENT - 1) / CHECKPOINT_ALIGNMENT * CHECKPOINT_ALIGNMENT;
+}
+
+// Collects sections and writes them into a file. Records are written straight from the arrays they are stored in
+class CheckpointWriter
+{
+private:
+	std::vector<CheckpointSection> sections;
+	std::vector<const void*> sectionData;
+
+public:
+	template <typename T>
+	void AddSection(CheckpointSectionId id, const T* records, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint records must be plain data");
+		sections.push_back({ id, static_cast<uint32_t>(sizeof(T)), static_cast<uint64_t>(count), 0 });
+		sectionData.push_back(records);
+	}
+
+	template <typename T>
+	void AddSection(CheckpointSectionId id, const std::vector<T>& records)
+	{
+		AddSection(id, records.data(), records.size());
+	}
+
+	void Write(const std::string& path)
+	{
+		size_t offset = AlignCheckpointOffset(sizeof(CheckpointHeader) + sections.size() * sizeof(CheckpointSection));
+		for (CheckpointSection& section : sections)
+		{
+			section.offset = offset;
+			offset = AlignCheckpointOffset(offset + section.recordSize * section.recordCount);
+		}
+
+		CheckpointHeader header = {};
+		std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+		header.version = CHECKPOINT_VERSION;
+		header.byteOrderMark = CHECKPOINT_BYTE_ORDER_MARK;
+		header.fileSize = offset;
+		header.sectionCount = static_cast<uint32_t>(sections.size());
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+			throw std::runtime_error("Can't create checkpoint file " + path);
+
+		const char padding[CHECKPOINT_ALIGNMENT] = {};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(sections.data()), sections.size() * sizeof(CheckpointSection));
+		size_t position = sizeof(header) + sections.size() * sizeof(CheckpointSection);
+		for (size_t i = 0; i < sections.size(); i++)
+		{
+			file.write(padding, sections[i].offset - position);
+			size_t size = sections[i].recordSize * sections[i].recordCount;
+			file.write(static_cast<const char*>(sectionData[i]), size);
+			position = sections[i].offset + size;
+		}
+		file.write(padding, offset - position);
+
+		file.close();
+		if (!file || !SyncCheckpointFile(path))
+			throw std::runtime_error("Can't write checkpoint file " + path);
+	}
+};
+
+// Whole file mapped read-only into memory
+class MappedFile
+{
+private:
+	const uint8_t* data;
+	size_t size;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int file;
+#endif
+
+public:
+	explicit MappedFile(const std::string& path) : data(nullptr), size(0)
+	{
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		LARGE_INTEGER fileSize;
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize))
+		{
+			if (file != INVALID_HANDLE_VALUE)
+				CloseHandle(file);
+			throw std::runtime_error("Can't open checkpoint file " + path);
+		}
+		size = static_cast<size_t>(fileSize.QuadPart);
+		mapping = size > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+		data = mapping ? static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+		if (!data)
+		{
+			if (mapping)
+				CloseHandle(mapping);
+			CloseHandle(file);
+			throw std::runtime_error("Can't map checkpoint file " + path);
+		}
+#else
+		file = open(path.c_str(), O_RDONLY);
+		struct stat fileStatus;
+		if (file < 0 || fstat(file, &fileStatus) != 0)
+		{
+			if (file >= 0)
+				close(file);
+			throw std::runtime_error("Can't open checkpoint file " + path);
+		}
+		size = static_cast<size_t>(fileStatus.st_size);
+		void* mapped = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+		if (mapped == MAP_FAILED)
+		{
+			close(file);
+			throw std::runtime_error("Can't map checkpoint file " + path);
+		}
+		data = static_cast<const uint8_t*>(mapped);
+#endif
+	}
+
+	~MappedFile()
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+		CloseHandle(mapping);
+		CloseHandle(file);
+#else
+		munmap(const_cast<uint8_t*>(data), size);
+		close(file);
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const uint8_t* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+};
+
+// Checks the header and the table of sections of a mapped checkpoint and gives access to the records of its sections
+class CheckpointReader
+{
+private:
+	const MappedFile& file;
+	const CheckpointSection* sections[CHECKPOINT_SECTION_COUNT] = {};
+
+public:
+	explicit CheckpointReader(const MappedFile& mappedFile) : file(mappedFile)
+	{
+		if (file.GetSize() < sizeof(CheckpointHeader))
+			throw std::runtime_error("Checkpoint file is too small");
+
+		CheckpointHeader header;
+		std::memcpy(&header, file.GetData(), sizeof(header));
+		if (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0)
+			throw std::runtime_error("File is not a checkpoint");
+		if (header.byteOrderMark != CHECKPOINT_BYTE_ORDER_MARK)
+			throw std::runtime_error("Checkpoint was saved on a machine with another byte order");
+		if (header.version != CHECKPOINT_VERSION)
+			throw std::runtime_error("Checkpoint version " + std::to_string(header.version) + " is not supported (expected " + std::to_string(CHECKPOINT_VERSION) + ")");
+		if (header.fileSize != file.GetSize() || header.sectionCount > (file.GetSize() - sizeof(header)) / sizeof(CheckpointSection))
+			throw std::runtime_error("Checkpoint file is truncated or damaged");
+
+		const CheckpointSection* table = reinterpret_cast<const CheckpointSection*>(file.GetData() + sizeof(header));
+		for (uint32_t i = 0; i < header.sectionCount; i++)
+		{
+			const CheckpointSection& section = table[i];
+			if (section.offset % CHECKPOINT_ALIGNMENT != 0 || section.offset > file.GetSize()
+				|| section.recordSize == 0 || section.recordCount > (file.GetSize() - section.offset) / section.recordSize)
+				throw std::runtime_error("Checkpoint file is truncated or damaged");
+
+			// Sections unknown to this version are skipped
+			if (section.id < CHECKPOINT_SECTION_COUNT)
+				sections[section.id] = &section;
+		}
+	}
+
+	size_t GetRecordCount(CheckpointSectionId id) const
+	{
+		if (!sections[id])
+			throw std::runtime_error("Checkpoint is missing section " + std::to_string(id));
+		return static_cast<size_t>(sections[id]->recordCount);
+	}
+
+	template <typename T>
+	const T* GetRecords(CheckpointSectionId id, size_t expectedCount) const
+	{
+		if (GetRecordCount(id) != expectedCount || sections[id]->recordSize != sizeof(T))
+			throw std::runtime_error("Checkpoint section " + std::to_string(id) + " has unexpected size");
+		return reinterpret_cast<const T*>(file.GetData() + sections[id]->offset);
+	}
+
+	// Copy the whole section into the array at once
+	template <typename T>
+	void CopyRecords(CheckpointSectionId id, size_t expectedCount, std::vector<T>& destination) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Checkpoint records must be plain data");
+		const T* records = GetRecords<T>(id, expectedCount);
+		destination.resize(expectedCount);
+		if (expectedCount > 0)
+			std::memcpy(destination.data(), records, expectedCount * sizeof(T));
+	}
+};
+
+bool IsBuildingIndexValid(int building, size_t buildingCount)
+{
+	return building == NO_BUILDING || (building >= 0 && static_cast<size_t>(building) < buildingCount);
+}
+
+// Save the state to a temporary file first, so a crash while saving doesn't destroy the previous checkpoint
+void Checkpoint::Save(const std::string& path, const Map& map, const Population& population, const SimulationTime& time)
+{
+	const PopulationStore& store = population.store;
+	if (store.map != &map)
+		throw std::invalid_argument("Population doesn't live on the given map");
+
+	CheckpointSimulation simulation = {};
+	simulation.mapSquareSize = map.mapSquareSize;
+	simulation.residentsInBuildingLimit = population.residentsInBuildingLimit;
+	simulation.randomSeed = store.randomSeed;
+	simulation.tick = store.tick;
+	simulation.ticksPerHour = store.ticksPerHour;
+	simulation.infectionMethod = population.infectionMethod;
+	simulation.diseaseModel = store.diseaseModel;
+	simulation.diseaseParameters = store.diseaseParameters;
+	simulation.timeAccumulator = time.timeAccumulator;
+	simulation.hourLength = time.hourLength;
+	simulation.timeScale = time.timeScale;
+	simulation.clockTicksPerHour = time.ticksPerHour;
+	simulation.maxTicksPerAdvance = time.maxTicksPerAdvance;
+	simulation.tickInHour = time.tickInHour;
+	simulation.hour = time.hour;
+	simulation.day = time.day;
+	simulation.hourChanged = time.hourChanged;
+
+	std::vector<CheckpointBlock> blocks;
+	blocks.reserve(map.mapBlocksList.size());
+	for (const MapBlock& block : map.mapBlocksList)
+	{
+		Vector2i baseSquare = block.GetOccupiedSquares().front();
+		blocks.push_back({ baseSquare.x, baseSquare.y, static_cast<uint8_t>(block.GetBlockSize()), static_cast<uint8_t>(block.GetAreaType()), {} });
+	}
+
+	const RoutingTable& routingTable = map.routingTable;
+	CheckpointRouting routing = { routingTable.width, routingTable.fieldStride, routingTable.destinationCount, routingTable.usesFlowFields };
+
+	CheckpointWriter writer;
+	writer.AddSection(SIMULATION_SECTION, &simulation, 1);
+	writer.AddSection(MAP_BLOCKS_SECTION, blocks);
+	writer.AddSection(BLOCKED_ROADS_SECTION, map.blockedRoads);
+	writer.AddSection(ROUTING_SECTION, &routing, 1);
+	writer.AddSection(ROUTING_DESTINATION_FIELDS_SECTION, routingTable.destinationFields);
+	writer.AddSection(ROUTING_COMPONENTS_SECTION, routingTable.components);
+	writer.AddSection(ROUTING_FLOW_FIELDS_SECTION, routingTable.flowFields);
+	writer.AddSection(POSITIONS_SECTION, store.positions);
+	writer.AddSection(STATES_SECTION, store.states);
+	writer.AddSection(INFECTION_TICKS_SECTION, store.infectionTicks);
+	writer.AddSection(HOUSES_SECTION, store.houses);
+	writer.AddSection(WORKPLACE_BUILDINGS_SECTION, store.workplaceBuildings);
+	writer.AddSection(SHOPPING_BUILDINGS_SECTION, store.shoppingBuildings);
+	writer.AddSection(CURRENT_BUILDINGS_SECTION, store.currentBuildings);
+	writer.AddSection(SCHEDULES_SECTION, store.schedules);
+	writer.AddSection(CURRENT_INTERSECTIONS_SECTION, store.currentIntersections);
+	writer.AddSection(NEXT_INTERSECTIONS_SECTION, store.nextIntersections);
+	writer.AddSection(NEXT_INTERSECTION_PIXELS_SECTION, store.nextIntersectionPixels);
+	writer.AddSection(TARGET_INTERSECTIONS_SECTION, store.targetIntersections);
+	writer.AddSection(REACHED_DESTINATIONS_SECTION, store.reachedDestinations);
+	writer.AddSection(DEPARTURE_TICKS_SECTION, store.departureTicks);
+	writer.AddSection(LEG_STARTS_SECTION, store.legStarts);
+	writer.AddSection(LEG_START_DISTANCES_SECTION, store.legStartDistances);
+
+	// The finished file replaces the previous checkpoint in one step, which is never deleted on its own.
+	// A failed save leaves no temporary file behind
+	std::string temporaryPath = path + ".tmp";
+	try
+	{
+		writer.Write(temporaryPath);
+	}
+	catch (...)
+	{
+		std::remove(temporaryPath.c_str());
+		throw;
+	}
+#ifdef _WIN32
+	bool replaced = MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	bool replaced = std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+	if (!replaced)
+	{
+		std::remove(temporaryPath.c_str());
+		throw std::runtime_error("Can't replace checkpoint file " + path);
+	}
+}
+
+// Rebuild the simulation from a checkpoint. The map's buildings are created again from its blocks (in the same order,
+// so saved building indices stay valid); the routing table and every array of the population are copied from the file
+SimulationCheckpoint Checkpoint::Load(const std::string& path)
+{
+	MappedFile file(path);
+	CheckpointReader reader(file);
+	const CheckpointSimulation& simulation = *reader.GetRecords<CheckpointSimulation>(SIMULATION_SECTION, 1);
+
+	// Map layout
+	if (simulation.mapSquareSize <= 0 || simulation.mapSquareSize > 1 << 15)
+		throw std::runtime_error("Checkpoint has invalid map size");
+
+	std::unique_ptr<Map> map(new Map());
+	map->mapSquareSize = simulation.mapSquareSize;
+	map->mapPixelSize = map->mapSquareSize * map->SQUARE_WIDTH + (map->mapSquareSize + 1) * map->ROAD_WIDTH;
+
+	size_t blockCount = reader.GetRecordCount(MAP_BLOCKS_SECTION);
+	const CheckpointBlock* blocks = reader.GetRecords<CheckpointBlock>(MAP_BLOCKS_SECTION, blockCount);
+	map->mapBlocksList.reserve(blockCount);
+	for (size_t i = 0; i < blockCount; i++)
+	{
+		const CheckpointBlock& block = blocks[i];
+		if (block.size >= SIZE_COUNT || block.areaType >= AREA_COUNT)
+			throw std::runtime_error("Checkpoint has invalid map block");
+
+		std::vector<Vector2i> squares;
+		for (const Vector2i& offset : BLOCK_SQUARE_OFFSETS[block.size])
+		{
+			Vector2i square = { block.baseX + offset.x, block.baseY + offset.y };
+			if (square.x < 0 || square.y < 0 || square.x >= map->mapSquareSize || square.y >= map->mapSquareSize)
+				throw std::runtime_error("Checkpoint has map block outside of the map");
+			squares.push_back(square);
+		}
+		map->mapBlocksList.emplace_back(std::move(squares), static_cast<Size>(block.size), static_cast<AreaType>(block.areaType));
+	}
+	map->IndexBlocks();
+	reader.CopyRecords(BLOCKED_ROADS_SECTION, static_cast<size_t>(map->GetIntersectionsWidth()) * map->GetIntersectionsWidth(), map->blockedRoads);
+	map->CreateBuildings();
+
+	// Routing table
+	const CheckpointRouting& routing = *reader.GetRecords<CheckpointRouting>(ROUTING_SECTION, 1);
+	size_t intersectionCount = static_cast<size_t>(map->GetIntersectionsWidth()) * map->GetIntersectionsWidth();
+	if (routing.width != map->GetIntersectionsWidth() || routing.fieldStride != static_cast<int>((intersectionCount + 3) / 4) || routing.destinationCount < 0)
+		throw std::runtime_error("Checkpoint routing table doesn't match the map");
+
+	RoutingTable& routingTable = map->routingTable;
+	routingTable.width = routing.width;
+	routingTable.fieldStride = routing.fieldStride;
+	routingTable.destinationCount = routing.destinationCount;
+	routingTable.usesFlowFields = routing.usesFlowFields != 0;
+	routingTable.buildTime = 0.0;
+	reader.CopyRecords(ROUTING_DESTINATION_FIELDS_SECTION, intersectionCount, routingTable.destinationFields);
+	reader.CopyRecords(ROUTING_COMPONENTS_SECTION, intersectionCount, routingTable.components);
+	size_t flowFieldsSize = routingTable.usesFlowFields ? static_cast<size_t>(routing.destinationCount) * routing.fieldStride : 0;
+	reader.CopyRecords(ROUTING_FLOW_FIELDS_SECTION, flowFieldsSize, routingTable.flowFields);
+	for (int field : routingTable.destinationFields)
+	{
+		if (field < -1 || field >= routing.destinationCount)
+			throw std::runtime_error("Checkpoint routing table is damaged");
+	}
+
+	// Population, created empty and filled with the arrays of the checkpoint
+	if (simulation.ticksPerHour <= 0 || simulation.residentsInBuildingLimit <= 0)
+		throw std::runtime_error("Checkpoint has invalid simulation parameters");
+
+	auto population = std::make_unique<Population>(0, map.get(), simulation.diseaseParameters, simulation.residentsInBuildingLimit, simulation.randomSeed);
+	population->infectionMethod = simulation.infectionMethod >= 0 && simulation.infectionMethod < INFECTION_METHOD_COUNT ? static_cast<InfectionMethod>(simulation.infectionMethod) : UniformGrid;
+
+	PopulationStore& store = population->store;
+	size_t personCount = reader.GetRecordCount(STATES_SECTION);
+	reader.CopyRecords(POSITIONS_SECTION, personCount, store.positions);
+	reader.CopyRecords(STATES_SECTION, personCount, store.states);
+	reader.CopyRecords(INFECTION_TICKS_SECTION, personCount, store.infectionTicks);
+	reader.CopyRecords(HOUSES_SECTION, personCount, store.houses);
+	reader.CopyRecords(WORKPLACE_BUILDINGS_SECTION, personCount, store.workplaceBuildings);
+	reader.CopyRecords(SHOPPING_BUILDINGS_SECTION, personCount, store.shoppingBuildings);
+	reader.CopyRecords(CURRENT_BUILDINGS_SECTION, personCount, store.currentBuildings);
+	reader.CopyRecords(SCHEDULES_SECTION, personCount, store.schedules);
+	reader.CopyRecords(CURRENT_INTERSECTIONS_SECTION, personCount, store.currentIntersections);
+	reader.CopyRecords(NEXT_INTERSECTIONS_SECTION, personCount, store.nextIntersections);
+	reader.CopyRecords(NEXT_INTERSECTION_PIXELS_SECTION, personCount, store.nextIntersectionPixels);
+	reader.CopyRecords(TARGET_INTERSECTIONS_SECTION, personCount, store.targetIntersections);
+	reader.CopyRecords(REACHED_DESTINATIONS_SECTION, personCount, store.reachedDestinations);
+	reader.CopyRecords(DEPARTURE_TICKS_SECTION, personCount, store.departureTicks);
+	reader.CopyRecords(LEG_STARTS_SECTION, personCount, store.legStarts);
+	reader.CopyRecords(LEG_START_DISTANCES_SECTION, personCount, store.legStartDistances);
+
+	size_t buildingCount = map->GetBuildingsList().size();
+	for (size_t i = 0; i < personCount; i++)
+	{
+		if (store.states[i] >= PERSON_STATE_COUNT || !IsBuildingIndexValid(store.houses[i], buildingCount) || !IsBuildingIndexValid(store.workplaceBuildings[i], buildingCount)
+			|| !IsBuildingIndexValid(store.shoppingBuildings[i], buildingCount) || !IsBuildingIndexValid(store.currentBuildings[i], buildingCount))
+			throw std::runtime_error("Checkpoint has invalid person data");
+	}
+
+	store.tick = simulation.tick;
+	store.diseaseModel = simulation.diseaseModel >= 0 && simulation.diseaseModel < DISEASE_MODEL_TYPE_COUNT ? static_cast<DiseaseModelType>(simulation.diseaseModel) : SIRD_MODEL;
+	store.SetTicksPerHour(simulation.ticksPerHour);
+
+	CompartmentCounts counts = store.CountCompartments();
+	store.stateCounts[Healthy] = counts.healthy;
+	store.stateCounts[Infected] = counts.infected;
+	store.stateCounts[Immune] = counts.immune;
+	store.stateCounts[Dead] = counts.dead;
+	store.stateCounts[Exposed] = counts.exposed;
+	population->BuildHourBuckets();
+	population->diseaseProgression.Reschedule();	// The events follow from the infection ticks and the parameters
+
+	// Clock
+	SimulationTime time(simulation.hourLength, simulation.clockTicksPerHour);
+	time.timeScale = simulation.timeScale;
+	time.maxTicksPerAdvance = simulation.maxTicksPerAdvance;
+	time.timeAccumulator = simulation.timeAccumulator;
+	time.tickInHour = simulation.tickInHour;
+	time.hour = simulation.hour;
+	time.day = simulation.day;
+	time.hourChanged = simulation.hourChanged != 0;
+
+	return { std::move(map), std::move(population), time };
+}
\ No newline at end of file
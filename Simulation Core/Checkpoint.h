@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Map.h"
+#include "Population.h"
+#include "SimulationTime.h"
+
+const uint32_t CHECKPOINT_VERSION = 5;	// Increased on every change of the format, older versions are rejected
+
+// Simulation restored from a checkpoint. The population refers to the map, so the map is declared (and kept alive) first
+struct SimulationCheckpoint
+{
+	std::unique_ptr<Map> map;
+	std::unique_ptr<Population> population;
+	SimulationTime time;
+};
+
+// Binary snapshot of the whole simulation state: the map layout and its routing table, every person's arrays
+// (including the trips, so positions that were not brought up to date yet continue the same way) and the clock. The file is a header and a table of sections followed by the sections themselves, each an array
+// of plain fixed-size records aligned to 8 bytes, so restoring maps the file into memory and copies every array
+// into the population store at once. Buildings are stored as indices into the map's buildings list.
+class Checkpoint
+{
+public:
+	static void Save(const std::string& path, const Map& map, const Population& population, const SimulationTime& time);	// Throws if the file can't be written
+	static SimulationCheckpoint Load(const std::string& path);	// Throws if the file can't be read, is damaged or has another version
+};
\ No newline at end of file
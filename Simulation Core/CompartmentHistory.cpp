@@ -0,0 +1,63 @@
+#include "CompartmentHistory.h"
+#include <stdexcept>
+
+CompartmentHistory::CompartmentHistory(int recentCapacity, int historyCapacity) :
+	recentSamples(recentCapacity),
+	recentStart(0),
+	recentCount(0),
+	historyCapacity(historyCapacity),
+	historyInterval(1),
+	sampleCount(0)
+{
+	if (recentCapacity <= 0 || historyCapacity < 2)
+		throw std::invalid_argument("History needs room for at least one recent and two history samples");
+
+	historySamples.reserve(historyCapacity);
+}
+
+void CompartmentHistory::AddSample(const CompartmentCounts& counts)
+{
+	// Overwrite the oldest recent sample when the ring buffer is full
+	int capacity = static_cast<int>(recentSamples.size());
+	if (recentCount < capacity)
+	{
+		recentSamples[(recentStart + recentCount) % capacity] = counts;
+		recentCount++;
+	}
+	else
+	{
+		recentSamples[recentStart] = counts;
+		recentStart = (recentStart + 1) % capacity;
+	}
+
+	if (sampleCount % historyInterval == 0)
+	{
+		// Drop every other sample when the history is full, so it covers twice as long with the same memory
+		if (static_cast<int>(historySamples.size()) == historyCapacity)
+		{
+			for (int i = 0; i < (historyCapacity + 1) / 2; i++)
+				historySamples[i] = historySamples[i * 2];
+			historySamples.resize((historyCapacity + 1) / 2);
+			historyInterval *= 2;
+		}
+
+		if (sampleCount % historyInterval == 0)
+			historySamples.push_back(counts);
+	}
+
+	sampleCount++;
+}
+
+void CompartmentHistory::Clear()
+{
+	recentStart = 0;
+	recentCount = 0;
+	historySamples.clear();
+	historyInterval = 1;
+	sampleCount = 0;
+}
+
+const CompartmentCounts& CompartmentHistory::GetRecentSample(int index) const
+{
+	return recentSamples[(recentStart + index) % recentSamples.size()];
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "PopulationStore.h"
+
+// Time series of the compartment counts with bounded memory. The most recent samples (one per tick) are kept
+// in a ring buffer, and the whole history is kept at a resolution that halves every time its buffer fills up.
+class CompartmentHistory
+{
+private:
+	// Recent samples, the oldest one at recentStart
+	std::vector<CompartmentCounts> recentSamples;
+	int recentStart;
+	int recentCount;
+
+	// Whole history, one sample every historyInterval ticks starting at tick 0
+	std::vector<CompartmentCounts> historySamples;
+	int historyCapacity;
+	uint64_t historyInterval;
+
+	uint64_t sampleCount;	// Number of samples added so far
+
+public:
+	CompartmentHistory(int recentCapacity, int historyCapacity);
+	void AddSample(const CompartmentCounts& counts);	// Add the counts after the next tick
+	void Clear();
+
+	int GetRecentCount() const { return recentCount; }
+	const CompartmentCounts& GetRecentSample(int index) const;	// Index 0 is the oldest recent sample
+	uint64_t GetRecentFirstTick() const { return sampleCount - recentCount; }	// Tick of the oldest recent sample
+
+	int GetHistoryCount() const { return static_cast<int>(historySamples.size()); }
+	const CompartmentCounts& GetHistorySample(int index) const { return historySamples[index]; }
+	uint64_t GetHistoryInterval() const { return historyInterval; }	// Ticks between history samples
+	uint64_t GetSampleCount() const { return sampleCount; }
+};
\ No newline at end of file
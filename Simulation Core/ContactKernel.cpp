@@ -0,0 +1,189 @@
+#include "ContactKernel.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// SSE2 is part of every 64-bit x86 processor, AVX2 has to be checked when the program runs
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTACT_KERNEL_SSE2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CONTACT_KERNEL_TARGET_AVX2
+#else
+#define CONTACT_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define CONTACT_KERNEL_SSE2 0
+#endif
+
+static int CountContactsScalar(int x, int y, const int* xs, const int* ys, int count, int contactDistance)
+{
+	int64_t contactDistanceSquared = static_cast<int64_t>(contactDistance) * contactDistance;
+	int contacts = 0;
+	for (int i = 0; i < count; i++)
+	{
+		int64_t dx = static_cast<int64_t>(xs[i]) - x;
+		int64_t dy = static_cast<int64_t>(ys[i]) - y;
+		contacts += dx * dx + dy * dy < contactDistanceSquared;
+	}
+	return contacts;
+}
+
+#if CONTACT_KERNEL_SSE2
+// The differences are clamped to the contact distance (which keeps farther people out of contact) so they fit
+// in 16 bits. Packing dx into the low and dy into the high half of every 32-bit lane lets a single multiply-add
+// compute dx * dx + dy * dy, and every lane in contact adds one to the counts (the comparison gives -1)
+
+static __m128i AbsSse2(__m128i value)
+{
+	__m128i sign = _mm_srai_epi32(value, 31);
+	return _mm_sub_epi32(_mm_xor_si128(value, sign), sign);
+}
+
+static __m128i MinSse2(__m128i first, __m128i second)
+{
+	__m128i firstIsLess = _mm_cmplt_epi32(first, second);
+	return _mm_or_si128(_mm_and_si128(firstIsLess, first), _mm_andnot_si128(firstIsLess, second));
+}
+
+static int CountContactsSse2(int x, int y, const int* xs, const int* ys, int count, int contactDistance)
+{
+	if (contactDistance > MAX_CONTACT_DISTANCE)
+		return CountContactsScalar(x, y, xs, ys, count, contactDistance);
+
+	__m128i pointX = _mm_set1_epi32(x);
+	__m128i pointY = _mm_set1_epi32(y);
+	__m128i distanceLimit = _mm_set1_epi32(contactDistance);
+	__m128i distanceSquaredLimit = _mm_set1_epi32(contactDistance * contactDistance);
+	__m128i counts = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i dx = MinSse2(AbsSse2(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i)), pointX)), distanceLimit);
+		__m128i dy = MinSse2(AbsSse2(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i)), pointY)), distanceLimit);
+		__m128i packed = _mm_or_si128(dx, _mm_slli_epi32(dy, 16));
+		__m128i distanceSquared = _mm_madd_epi16(packed, packed);
+		counts = _mm_sub_epi32(counts, _mm_cmplt_epi32(distanceSquared, distanceSquaredLimit));
+	}
+
+	alignas(16) int laneCounts[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(laneCounts), counts);
+	int contacts = laneCounts[0] + laneCounts[1] + laneCounts[2] + laneCounts[3];
+	return contacts + CountContactsScalar(x, y, xs + i, ys + i, count - i, contactDistance);
+}
+
+CONTACT_KERNEL_TARGET_AVX2 static int CountContactsAvx2(int x, int y, const int* xs, const int* ys, int count, int contactDistance)
+{
+	if (contactDistance > MAX_CONTACT_DISTANCE)
+		return CountContactsScalar(x, y, xs, ys, count, contactDistance);
+
+	__m256i pointX = _mm256_set1_epi32(x);
+	__m256i pointY = _mm256_set1_epi32(y);
+	__m256i distanceLimit = _mm256_set1_epi32(contactDistance);
+	__m256i distanceSquaredLimit = _mm256_set1_epi32(contactDistance * contactDistance);
+	__m256i counts = _mm256_setzero_si256();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i dx = _mm256_min_epi32(_mm256_abs_epi32(_mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i)), pointX)), distanceLimit);
+		__m256i dy = _mm256_min_epi32(_mm256_abs_epi32(_mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i)), pointY)), distanceLimit);
+		__m256i packed = _mm256_or_si256(dx, _mm256_slli_epi32(dy, 16));
+		__m256i distanceSquared = _mm256_madd_epi16(packed, packed);
+		counts = _mm256_sub_epi32(counts, _mm256_cmpgt_epi32(distanceSquaredLimit, distanceSquared));
+	}
+
+	alignas(32) int laneCounts[8];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(laneCounts), counts);
+	int contacts = 0;
+	for (int lane = 0; lane < 8; lane++)
+		contacts += laneCounts[lane];
+	return contacts + CountContactsScalar(x, y, xs + i, ys + i, count - i, contactDistance);
+}
+
+static bool HasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	// The processor has to support the instructions and the system has to save the 256-bit registers
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	bool hasAvx = (info[2] & (1 << 28)) != 0;
+	bool hasSavedRegisters = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+	if (!hasAvx || !hasSavedRegisters)
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+bool IsContactKernelSupported(ContactKernelType type)
+{
+	switch (type)
+	{
+	case SCALAR_CONTACT_KERNEL:
+		return true;
+#if CONTACT_KERNEL_SSE2
+	case SSE2_CONTACT_KERNEL:
+		return true;
+	case AVX2_CONTACT_KERNEL:
+	{
+		static const bool hasAvx2 = HasAvx2();
+		return hasAvx2;
+	}
+#endif
+	default:
+		return false;
+	}
+}
+
+ContactKernelType GetFastestContactKernel()
+{
+	for (int type = CONTACT_KERNEL_TYPE_COUNT - 1; type > SCALAR_CONTACT_KERNEL; type--)
+	{
+		if (IsContactKernelSupported(static_cast<ContactKernelType>(type)))
+			return static_cast<ContactKernelType>(type);
+	}
+	return SCALAR_CONTACT_KERNEL;
+}
+
+ContactCountFunction GetContactKernel(ContactKernelType type)
+{
+	if (!IsContactKernelSupported(type))
+		throw std::invalid_argument(std::string("Contact kernel ") + GetContactKernelName(type) + " is not supported by this processor");
+
+	switch (type)
+	{
+#if CONTACT_KERNEL_SSE2
+	case SSE2_CONTACT_KERNEL:
+		return CountContactsSse2;
+	case AVX2_CONTACT_KERNEL:
+		return CountContactsAvx2;
+#endif
+	default:
+		return CountContactsScalar;
+	}
+}
+
+const char* GetContactKernelName(ContactKernelType type)
+{
+	switch (type)
+	{
+	case SCALAR_CONTACT_KERNEL:
+		return "scalar";
+	case SSE2_CONTACT_KERNEL:
+		return "sse2";
+	case AVX2_CONTACT_KERNEL:
+		return "avx2";
+	default:
+		return "unknown";
+	}
+}
\ No newline at end of file
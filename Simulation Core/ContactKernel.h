@@ -0,0 +1,29 @@
+#pragma once
+#include <cmath>
+
+// Implementations of the contact count, from the slowest to the fastest
+enum ContactKernelType
+{
+	SCALAR_CONTACT_KERNEL,
+	SSE2_CONTACT_KERNEL,	// 4 people at a time
+	AVX2_CONTACT_KERNEL,	// 8 people at a time
+	CONTACT_KERNEL_TYPE_COUNT
+};
+
+// Count the people (given by contiguous arrays of their coordinates) closer to the point than contactDistance pixels
+typedef int (*ContactCountFunction)(int x, int y, const int* xs, const int* ys, int count, int contactDistance);
+
+// People are in contact when the distance between them, rounded down to whole pixels, is less than twice
+// the infection radius. That is the same as the squared distance being less than the square of the returned value,
+// so contacts are found with integers only
+inline int GetContactDistance(float infectionRadius)
+{
+	return infectionRadius > 0.0f ? static_cast<int>(std::ceil(infectionRadius * 2)) : 0;
+}
+
+const int MAX_CONTACT_DISTANCE = 32767;	// Differences are clamped to the contact distance and squared in 16-bit lanes
+
+bool IsContactKernelSupported(ContactKernelType type);	// Whether the processor running the program has the instructions of the kernel
+ContactKernelType GetFastestContactKernel();	// Checked once, when the program runs
+ContactCountFunction GetContactKernel(ContactKernelType type);	// Throws if the kernel is not supported
+const char* GetContactKernelName(ContactKernelType type);
\ No newline at end of file
@@ -0,0 +1,14 @@
+#include "DiseaseModel.h"
+
+const char* GetDiseaseModelName(DiseaseModelType type)
+{
+	switch (type)
+	{
+	case SIRD_MODEL:
+		return "sir-d";
+	case SEIR_MODEL:
+		return "seir";
+	default:
+		return "unknown";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+#include "DiseaseParameters.h"
+#include "Person.h"
+#include "PopulationStore.h"
+
+// Part a health state plays in the spread of the disease
+enum CompartmentRole : uint8_t
+{
+	SUSCEPTIBLE_ROLE,	// Can get infected
+	CARRIER_ROLE,	// Has the disease and infects the people they meet (unless the model says otherwise)
+	LATENT_ROLE,	// Has the disease, but doesn't infect anybody yet
+	REMOVED_ROLE	// Takes no part in the spread
+};
+
+// Transitions of the course of the disease, made by the events of the same type (DiseaseProgression). A transition only
+// changes people in state FROM, events left after the person moved on (died, recovered) are dropped
+struct BecomeInfectiousTransition
+{
+	static constexpr PersonState FROM = Exposed;
+
+	void operator()(PopulationStore& store, int index) const
+	{
+		store.SetState(index, Infected);
+	}
+};
+
+struct GoToHospitalTransition
+{
+	static constexpr PersonState FROM = Infected;
+
+	void operator()(PopulationStore& store, int index) const
+	{
+		Person person(&store, index);
+		if (!person.IsInHospital())
+			person.PrepareToMoveToBuilding(store.hospitalBuilding);
+	}
+};
+
+struct DieTransition
+{
+	static constexpr PersonState FROM = Infected;
+
+	void operator()(PopulationStore& store, int index) const
+	{
+		Person(&store, index).UpdatePosition(store.tick);	// Dead people stay where they died
+		store.SetState(index, Dead);
+	}
+};
+
+// Become immune and go home from the hospital
+struct RecoverTransition
+{
+	static constexpr PersonState FROM = Infected;
+
+	void operator()(PopulationStore& store, int index) const
+	{
+		Person person(&store, index);
+		store.SetState(index, Immune);
+		if (person.IsInHospital())
+			person.PrepareToMoveToBuilding(store.houses[index]);
+	}
+};
+
+// Compartment models are policies given to the passes of the population as template parameters, so every model
+// compiles into its own loops with the table and the functions below inlined, instead of checking the model
+// for every person. A model has:
+//  ROLES				constexpr table of the role of every stored health state
+//  INFECTION_STATE		state a person gets infected into
+//  IsInfectious		whether a carrier infects the people they meet
+//  GetLatentHours		hours from the infection to the start of the course of the disease (symptoms, hospital, death, recovery)
+//  BecomeInfectious, GoToHospital, Die, Recover		transition functors applied by the events of the disease
+// The tick of the population is instantiated for every model in the .cpp files and picked once per tick with VisitDiseaseModel,
+// everything it runs (event application, transitions, infection pass) is compiled for the model.
+
+// Infected people are infectious from the tick after the infection until they recover or die, except in the hospital.
+// There is no latent period, so people left exposed by another model are infectious too
+struct SirdModel
+{
+	static constexpr DiseaseModelType TYPE = SIRD_MODEL;
+	static constexpr CompartmentRole ROLES[PERSON_STATE_COUNT] = { SUSCEPTIBLE_ROLE, CARRIER_ROLE, REMOVED_ROLE, REMOVED_ROLE, CARRIER_ROLE };
+	static constexpr PersonState INFECTION_STATE = Infected;
+	using BecomeInfectious = BecomeInfectiousTransition;
+	using GoToHospital = GoToHospitalTransition;
+	using Die = DieTransition;
+	using Recover = RecoverTransition;
+
+	static bool IsInfectious(const PopulationStore& store, int index)
+	{
+		return store.currentBuildings[index] != store.hospitalBuilding;
+	}
+
+	static double GetLatentHours(const DiseaseParameters&)
+	{
+		return 0.0;
+	}
+};
+
+// Infected people are exposed for the latent period first: they carry the disease but don't infect anybody.
+// When it ends they become infected (DiseaseProgression) and the course of the SIR-D model starts
+struct SeirModel : SirdModel
+{
+	static constexpr DiseaseModelType TYPE = SEIR_MODEL;
+	static constexpr CompartmentRole ROLES[PERSON_STATE_COUNT] = { SUSCEPTIBLE_ROLE, CARRIER_ROLE, REMOVED_ROLE, REMOVED_ROLE, LATENT_ROLE };
+	static constexpr PersonState INFECTION_STATE = Exposed;
+
+	static double GetLatentHours(const DiseaseParameters& parameters)
+	{
+		return parameters.hoursToGetInfectious > 0.0f ? parameters.hoursToGetInfectious : 0.0;
+	}
+};
+
+// Call function with a value of the policy of the model (the only check of the model in a pass)
+template <class Function>
+void VisitDiseaseModel(DiseaseModelType type, Function&& function)
+{
+	switch (type)
+	{
+	case SEIR_MODEL:
+		function(SeirModel());
+		break;
+	default:
+		function(SirdModel());
+		break;
+	}
+}
+
+const char* GetDiseaseModelName(DiseaseModelType type);
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+// Compartment model the course of the disease follows (DiseaseModel.h)
+enum DiseaseModelType
+{
+    SIRD_MODEL,     // Healthy, infected, immune or dead, infected people are infectious at once
+    SEIR_MODEL,     // Same, but infected people are only exposed (not infectious) for the latent period first
+    DISEASE_MODEL_TYPE_COUNT
+};
+
+struct DiseaseParameters
+{
+    float infectionProbabilityPerHour;
+    float deathProbabilityPerHour;
+    float deathProbabilityPerHourInHospital;
+    float probabilityOfGoingToHospitalPerHour;
+    float hoursToGetImmune;
+    float hoursToGetSymptoms;
+    float infectionRadius;
+    float hoursToGetInfectious;     // Latent period of the SEIR model, ignored by the SIR-D model
+};
\ No newline at end of file
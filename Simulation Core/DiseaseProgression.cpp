@@ -0,0 +1,130 @@
+#include "DiseaseProgression.h"
+#include "DiseaseModel.h"
+#include "Person.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Rate of an event with the given probability of happening within an hour. A certain event gets a very high but finite rate,
+// so it still happens within minutes
+static double GetRatePerHour(float probabilityPerHour)
+{
+	double probability = std::min(std::max(static_cast<double>(probabilityPerHour), 0.0), 1.0 - 1e-12);
+	return -std::log1p(-probability);
+}
+
+// Exponentially distributed waiting time in hours, infinite if the event can't happen
+static double SampleWaitingTime(double ratePerHour, RandomStream& random)
+{
+	double threshold = -std::log1p(-random.NextDouble());
+	return ratePerHour > 0.0 ? threshold / ratePerHour : std::numeric_limits<double>::infinity();
+}
+
+void DiseaseProgression::ScheduleInfection(int index, uint32_t firstTick)
+{
+	VisitDiseaseModel(store->diseaseModel, [&](auto model) { ScheduleInfection<decltype(model)>(index, firstTick); });
+}
+
+template <class Model>
+void DiseaseProgression::ScheduleInfection(int index, uint32_t firstTick)
+{
+	const DiseaseParameters& parameters = store->diseaseParameters;
+	RandomStream random(store->randomSeed, index, store->infectionTicks[index], PROGRESSION_STREAM);
+
+	double latentHours = Model::GetLatentHours(parameters);
+	double hoursToSymptoms = latentHours + parameters.hoursToGetSymptoms;
+	double hoursToRecovery = latentHours + parameters.hoursToGetImmune;
+	double deathRate = GetRatePerHour(parameters.deathProbabilityPerHour);
+	double deathRateInHospital = GetRatePerHour(parameters.deathProbabilityPerHourInHospital);
+	double hoursToHospital = hoursToSymptoms + SampleWaitingTime(GetRatePerHour(parameters.probabilityOfGoingToHospitalPerHour), random);
+
+	// The person dies when the risk accumulated since the symptoms (at one rate outside the hospital and at another inside)
+	// reaches an exponentially distributed threshold, which is the continuous version of trying to die every tick
+	double deathThreshold = -std::log1p(-random.NextDouble());
+	double riskBeforeHospital = deathRate > 0.0 ? deathRate * (hoursToHospital - hoursToSymptoms) : 0.0;
+	double hoursToDeath = std::numeric_limits<double>::infinity();
+	if (deathThreshold <= riskBeforeHospital)
+		hoursToDeath = hoursToSymptoms + deathThreshold / deathRate;
+	else if (deathRateInHospital > 0.0 && std::isfinite(hoursToHospital))
+		hoursToDeath = hoursToHospital + (deathThreshold - riskBeforeHospital) / deathRateInHospital;
+
+	// Exposed people become infected when the latent period ends (right away if the model has none)
+	if (store->states[index] == Model::BecomeInfectious::FROM)
+		PushEvent(index, BECOME_INFECTIOUS_EVENT, latentHours, firstTick);
+
+	// Recovery ends the disease, so nothing that would come after it is scheduled
+	if (hoursToHospital < hoursToDeath && hoursToHospital < hoursToRecovery)
+		PushEvent(index, GO_TO_HOSPITAL_EVENT, hoursToHospital, firstTick);
+	if (hoursToDeath < hoursToRecovery)
+		PushEvent(index, DEATH_EVENT, hoursToDeath, firstTick);
+	PushEvent(index, RECOVERY_EVENT, hoursToRecovery, firstTick);
+}
+
+template void DiseaseProgression::ScheduleInfection<SirdModel>(int index, uint32_t firstTick);
+template void DiseaseProgression::ScheduleInfection<SeirModel>(int index, uint32_t firstTick);
+
+// The event happens in the first tick after the given time has passed since the infection. Events that are overdue
+// (the parameters changed after the time passed) happen in the first tick, so nobody stays infected forever
+void DiseaseProgression::PushEvent(int index, DiseaseEventType type, double hoursSinceInfection, uint32_t firstTick)
+{
+	double tick = store->infectionTicks[index] + std::floor(hoursSinceInfection * store->ticksPerHour) + 1.0;
+	if (!(tick <= std::numeric_limits<uint32_t>::max()))
+		return;
+
+	events.push({ static_cast<uint32_t>(std::max(tick, static_cast<double>(firstTick))), index, type });
+}
+
+void DiseaseProgression::Reschedule()
+{
+	events = {};
+	VisitDiseaseModel(store->diseaseModel, [&](auto model) {
+		for (size_t i = 0; i < store->GetSize(); ++i)
+		{
+			CompartmentRole role = decltype(model)::ROLES[store->states[i]];
+			if (role == CARRIER_ROLE || role == LATENT_ROLE)
+				ScheduleInfection<decltype(model)>(static_cast<int>(i), store->tick);
+		}
+	});
+}
+
+void DiseaseProgression::ApplyEventsDue()
+{
+	VisitDiseaseModel(store->diseaseModel, [&](auto model) { ApplyEventsDue<decltype(model)>(); });
+}
+
+template <class Model>
+void DiseaseProgression::ApplyEventsDue()
+{
+	while (!events.empty() && events.top().tick <= store->tick)
+	{
+		DiseaseEvent event = events.top();
+		events.pop();
+
+		switch (event.type)
+		{
+		case BECOME_INFECTIOUS_EVENT:
+			ApplyTransition<typename Model::BecomeInfectious>(event.person);
+			break;
+		case GO_TO_HOSPITAL_EVENT:
+			ApplyTransition<typename Model::GoToHospital>(event.person);
+			break;
+		case DEATH_EVENT:
+			ApplyTransition<typename Model::Die>(event.person);
+			break;
+		case RECOVERY_EVENT:
+			ApplyTransition<typename Model::Recover>(event.person);
+			break;
+		}
+	}
+}
+
+template void DiseaseProgression::ApplyEventsDue<SirdModel>();
+template void DiseaseProgression::ApplyEventsDue<SeirModel>();
+
+template <class Transition>
+void DiseaseProgression::ApplyTransition(int index)
+{
+	if (store->states[index] == Transition::FROM)
+		Transition()(*store, index);
+}
\ No newline at end of file
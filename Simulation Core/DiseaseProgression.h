@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include "PopulationStore.h"
+
+// Changes of the health of an infected person, in the order they are applied when they fall in the same tick
+enum DiseaseEventType : uint8_t
+{
+	BECOME_INFECTIOUS_EVENT,	// End of the latent period of an exposed person
+	GO_TO_HOSPITAL_EVENT,
+	DEATH_EVENT,
+	RECOVERY_EVENT
+};
+
+struct DiseaseEvent
+{
+	uint32_t tick;	// Tick at the start of which the event is applied
+	int person;
+	DiseaseEventType type;
+};
+
+// Orders the queue by tick (earliest on top), ties are broken by person and type so the order never depends on the order of pushing
+struct LaterDiseaseEvent
+{
+	bool operator()(const DiseaseEvent& first, const DiseaseEvent& second) const
+	{
+		if (first.tick != second.tick)
+			return first.tick > second.tick;
+		if (first.person != second.person)
+			return first.person > second.person;
+		return first.type > second.type;
+	}
+};
+
+// Course of the disease of every infected person, decided once when the person gets infected. The hourly probabilities
+// of going to the hospital and of dying (from the onset of symptoms) are turned into exponentially distributed waiting
+// times in simulated hours, and the resulting events wait in a priority queue until their tick comes, so infected people
+// cost nothing between the events and the outcome doesn't depend on the number of ticks per hour.
+// Every course comes from the person's own random stream keyed by the tick of infection, so rescheduling it
+// (after a change of the parameters or restoring a checkpoint) gives the same events. The course is shifted
+// by the latent period of the store's compartment model (DiseaseModel.h), which exposed people become infected after.
+class DiseaseProgression
+{
+private:
+	PopulationStore* store;
+	std::priority_queue<DiseaseEvent, std::vector<DiseaseEvent>, LaterDiseaseEvent> events;
+
+	void PushEvent(int index, DiseaseEventType type, double hoursSinceInfection, uint32_t firstTick);
+	template <class Transition> void ApplyTransition(int index);
+
+public:
+	explicit DiseaseProgression(PopulationStore* store) : store(store) {}
+	void ScheduleInfection(int index) { ScheduleInfection(index, store->tick); }	// Schedule the course of the disease of a person infected in the current tick
+	void ScheduleInfection(int index, uint32_t firstTick);	// Same, events due before the given tick happen in it
+	template <class Model> void ScheduleInfection(int index, uint32_t firstTick);	// Same for the given model, for passes instantiated per model
+	void Reschedule();	// Drop all events and schedule the rest of the disease of every infected and exposed person with the current parameters (overdue events happen in the current tick)
+	void ApplyEventsDue();	// Apply the events of the current tick
+	template <class Model> void ApplyEventsDue();	// Same with the transitions of the given model, for passes instantiated per model
+	size_t GetPendingEventCount() const { return events.size(); }
+};
\ No newline at end of file
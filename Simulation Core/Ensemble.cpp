@@ -0,0 +1,92 @@
+#include "Ensemble.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include "WorkStealingPool.h"
+
+Ensemble::Ensemble(const Map& map, const EnsembleSettings& settings) :
+	map(map), settings(settings), hourCount(settings.run.days * 24), runTime(0.0), threadCount(0), steals(0)
+{
+	if (settings.replicateCount <= 0 || settings.run.days <= 0)
+		throw std::invalid_argument("Ensemble needs at least one replicate of at least one day");
+}
+
+void Ensemble::Run(int newThreadCount)
+{
+	hourlyCounts.assign(static_cast<size_t>(settings.replicateCount) * hourCount, CompartmentCounts{});
+
+	// Replicates can be faster than others (e.g. when the disease dies out early), which the stealing evens out
+	WorkStealingPool pool(newThreadCount);
+	auto startTime = std::chrono::steady_clock::now();
+	pool.Run(settings.replicateCount, [this](int replicate, int) {
+		CompartmentCounts* counts = &hourlyCounts[static_cast<size_t>(replicate) * hourCount];
+		RunSimulation(map, settings.run, settings.firstSeed + replicate, [counts](int hour, const CompartmentCounts& hourCounts) { counts[hour] = hourCounts; });
+	});
+	std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+	runTime = elapsedTime.count();
+	threadCount = pool.GetThreadCount();
+	steals = pool.GetSteals();
+}
+
+// Value of the given rank in the replicates sorted by a count
+static int NearestRankIndex(int valueCount, float quantile)
+{
+	int rank = static_cast<int>(std::ceil(quantile * valueCount));
+	return std::clamp(rank - 1, 0, valueCount - 1);
+}
+
+CompartmentCounts Ensemble::GetQuantile(int hour, float quantile) const
+{
+	if (hour < 0 || hour >= hourCount || hourlyCounts.empty())
+		throw std::out_of_range("Ensemble hour out of range or ensemble not run");
+
+	std::vector<int> values(settings.replicateCount);
+	int index = NearestRankIndex(settings.replicateCount, quantile);
+	CompartmentCounts result;
+	for (int CompartmentCounts::* count : { &CompartmentCounts::healthy, &CompartmentCounts::exposed, &CompartmentCounts::infected, &CompartmentCounts::immune, &CompartmentCounts::dead })
+	{
+		for (int replicate = 0; replicate < settings.replicateCount; replicate++)
+			values[replicate] = GetCounts(replicate, hour).*count;
+		std::nth_element(values.begin(), values.begin() + index, values.end());
+		result.*count = values[index];
+	}
+	return result;
+}
+
+void Ensemble::WriteQuantiles(const std::string& path, const std::vector<float>& quantiles) const
+{
+	std::ofstream file(path, std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Can't create ensemble file " + path);
+
+	const char* const names[] = { "healthy", "exposed", "infected", "immune", "dead" };
+	int CompartmentCounts::* const counts[] = { &CompartmentCounts::healthy, &CompartmentCounts::exposed, &CompartmentCounts::infected, &CompartmentCounts::immune, &CompartmentCounts::dead };
+
+	file << "day,hour";
+	for (const char* name : names)
+		for (float quantile : quantiles)
+			file << ',' << name << "_q" << quantile;
+	file << '\n';
+
+	// Every count is sorted once per hour and all quantiles are read from it
+	std::vector<int> values(settings.replicateCount);
+	for (int hour = 0; hour < hourCount; hour++)
+	{
+		file << GetDayOfHour(hour) << ',' << GetHourOfDay(hour);
+		for (int CompartmentCounts::* count : counts)
+		{
+			for (int replicate = 0; replicate < settings.replicateCount; replicate++)
+				values[replicate] = GetCounts(replicate, hour).*count;
+			std::sort(values.begin(), values.end());
+			for (float quantile : quantiles)
+				file << ',' << values[NearestRankIndex(settings.replicateCount, quantile)];
+		}
+		file << '\n';
+	}
+
+	if (!file.flush())
+		throw std::runtime_error("Can't write ensemble file " + path);
+}
\ No newline at end of file
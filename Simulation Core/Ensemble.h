@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Map.h"
+#include "SimulationRun.h"
+
+// Settings shared by all replicates of an ensemble
+struct EnsembleSettings
+{
+	int replicateCount;
+	uint64_t firstSeed;	// Replicate i uses the seed firstSeed + i
+	RunSettings run;
+};
+
+// Monte Carlo ensemble: many independent runs (replicates) of the same scenario, differing only in their random seed.
+// All replicates share one map, which is only read, and every replicate owns its population.
+// Replicates run whole on one thread each, spread over a work-stealing pool, and the compartment counts
+// of every replicate at the start of every hour are kept to compute quantiles over the replicates.
+class Ensemble
+{
+private:
+	const Map& map;
+	EnsembleSettings settings;
+	int hourCount;
+	std::vector<CompartmentCounts> hourlyCounts;	// Counts of replicate r in hour h are at r * hourCount + h
+	double runTime;
+	int threadCount;
+	unsigned long long steals;
+
+public:
+	Ensemble(const Map& map, const EnsembleSettings& settings);	// Throws if there is no replicate to run
+
+	void Run(int threadCount);	// Run all replicates (0 threads uses all hardware threads), throws if a replicate fails
+
+	int GetReplicateCount() const { return settings.replicateCount; }
+	int GetHourCount() const { return hourCount; }
+	int GetDayOfHour(int hour) const { return (hour + 1) / 24 + 1; }	// Hour indices start at the first hour change, 1 o'clock of day 1
+	int GetHourOfDay(int hour) const { return (hour + 1) % 24; }
+	const CompartmentCounts& GetCounts(int replicate, int hour) const { return hourlyCounts[static_cast<size_t>(replicate) * hourCount + hour]; }
+	CompartmentCounts GetQuantile(int hour, float quantile) const;	// Nearest-rank quantile (between 0 and 1) of every count over the replicates
+
+	double GetRunTime() const { return runTime; }	// In seconds
+	double GetReplicatesPerSecond() const { return runTime > 0.0 ? settings.replicateCount / runTime : 0.0; }
+	int GetThreadCount() const { return threadCount; }
+	unsigned long long GetSteals() const { return steals; }
+
+	void WriteQuantiles(const std::string& path, const std::vector<float>& quantiles) const;	// CSV of every quantile of every count in every hour, throws if the file can't be written
+};
\ No newline at end of file
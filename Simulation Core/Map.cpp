@@ -0,0 +1,289 @@
+#include "Map.h"
+#include "Vector2i.h"
+#include "Building.h"
+#include "MapBlock.h"
+#include "Random.h"
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+// Area types of randomly generated blocks and their weights
+const AreaType RANDOM_AREA_TYPES[] = { AreaType::RESIDENTIAL_AREA, AreaType::GREEN_AREA, AreaType::SHOPPING_AREA, AreaType::WORKPLACE_AREA };
+const int RANDOM_AREA_TYPE_WEIGHTS[] = { 70, 18, 5, 7 };
+
+// Squares of the map that are not assigned to any block yet. The bitmap tells in O(1) whether a square is free,
+// and the free list removes any square in O(1) by swapping it with the last one.
+class UnassignedSquares
+{
+private:
+	int mapSquareSize;
+	std::vector<uint8_t> freeSquares;		// 1 for every square that is not assigned yet
+	std::vector<Vector2i> freeList;
+	std::vector<int> freeListPositions;		// Position of every square in the free list
+
+	int GetSquareIndex(Vector2i square) const { return square.y * mapSquareSize + square.x; }
+
+public:
+	UnassignedSquares(int mapSquareSize, std::mt19937& randomGenerator) : mapSquareSize(mapSquareSize),
+		freeSquares(mapSquareSize * mapSquareSize, 1), freeListPositions(mapSquareSize * mapSquareSize)
+	{
+		// Prepare list for map squares and shuffle it
+		freeList.reserve(mapSquareSize * mapSquareSize);
+		for (int i = 0; i < mapSquareSize; i++)
+			for (int j = 0; j < mapSquareSize; j++)
+				freeList.push_back({ i, j });
+		std::shuffle(freeList.begin(), freeList.end(), randomGenerator);
+
+		for (size_t i = 0; i < freeList.size(); i++)
+			freeListPositions[GetSquareIndex(freeList[i])] = static_cast<int>(i);
+	}
+
+	bool IsFree(Vector2i square) const
+	{
+		return square.x >= 0 && square.y >= 0 && square.x < mapSquareSize && square.y < mapSquareSize && freeSquares[GetSquareIndex(square)];
+	}
+
+	void Remove(Vector2i square)
+	{
+		int position = freeListPositions[GetSquareIndex(square)];
+		freeList[position] = freeList.back();
+		freeListPositions[GetSquareIndex(freeList[position])] = position;
+		freeList.pop_back();
+		freeSquares[GetSquareIndex(square)] = 0;
+	}
+
+	bool IsEmpty() const { return freeList.empty(); }
+	Vector2i Back() const { return freeList.back(); }
+	const std::vector<Vector2i>& GetFreeList() const { return freeList; }
+};
+
+// Check if the block of chosen size fits in the free squares of the map
+bool CanFormBlock(Vector2i baseSquare, Size size, const UnassignedSquares& unassignedSquares)
+{
+	for (const Vector2i& offset : BLOCK_SQUARE_OFFSETS[size])
+	{
+		if (!unassignedSquares.IsFree({ baseSquare.x + offset.x, baseSquare.y + offset.y }))
+			return false;
+	}
+	return true;
+}
+
+Map::Map(int populationSize, int residentsInBuildingLimit)
+{
+	if (populationSize <= 0 || residentsInBuildingLimit <= 0)
+		throw std::invalid_argument("Population size and residents in building limit must be greater than zero.");
+
+	int requiredResidentialBuildings = static_cast<int>(std::ceil(static_cast<float>(populationSize) / residentsInBuildingLimit));
+	int totalSquares = static_cast<int>(std::ceil(requiredResidentialBuildings / 0.7f));
+
+	mapSquareSize = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(totalSquares)))) + 1;
+	mapPixelSize = mapSquareSize * SQUARE_WIDTH + (mapSquareSize + 1) * ROAD_WIDTH;
+	blockedRoads.assign(GetIntersectionsWidth() * GetIntersectionsWidth(), 0);
+}
+
+// Generate the map blocks and buildings
+void Map::GenerateMap()
+{
+	// Prepare RNG
+	std::mt19937& randomGenerator = GetRandomGenerator();
+	std::discrete_distribution<> areaTypeDistribution(std::begin(RANDOM_AREA_TYPE_WEIGHTS), std::end(RANDOM_AREA_TYPE_WEIGHTS));
+	std::uniform_int_distribution<int> randomSizeEnumDistribution(0, static_cast<int>(Size::SIZE_COUNT) - 2);	// Without STANDARD size
+
+	// Determine number of attempts to be taken when placing large blocks on the map
+	long long largeBlocksPlacementAttempts = std::llround(static_cast<double>(mapSquareSize) * mapSquareSize * LARGE_BLOCKS_PLACEMENT_INTENSITY);
+
+	UnassignedSquares unassignedSquares(mapSquareSize, randomGenerator);
+	mapBlocksList.clear();
+	mapBlocksList.reserve(mapSquareSize * mapSquareSize);
+
+	// Generate hospital block at the center of the map
+	Vector2i originHospitalSquare = { static_cast<int>(mapSquareSize / 2), static_cast<int>(mapSquareSize / 2) };
+	mapBlocksList.emplace_back(std::vector<Vector2i>{ originHospitalSquare }, Size::STANDARD, AreaType::HOSPITAL);
+	unassignedSquares.Remove(originHospitalSquare);
+
+	// Perform attempts to create large map blocks
+	while (largeBlocksPlacementAttempts > 0 && !unassignedSquares.IsEmpty())
+	{
+		// Choose last unassigned square
+		Vector2i resultSquare = unassignedSquares.Back();
+
+		// Failed attempts are repeated on the same square, so stop when no large block fits there at all
+		bool anySizeFits = false;
+		for (int size = 0; size < static_cast<int>(Size::STANDARD) && !anySizeFits; size++)
+			anySizeFits = CanFormBlock(resultSquare, static_cast<Size>(size), unassignedSquares);
+		if (!anySizeFits)
+			break;
+
+		// Randomly choose size and area type of the block to be generated
+		Size resultSize = static_cast<Size>(randomSizeEnumDistribution(randomGenerator));
+		AreaType resultAreaType = RANDOM_AREA_TYPES[areaTypeDistribution(randomGenerator)];
+
+		// Form the block and add it to the list of all map blocks
+		if (CanFormBlock(resultSquare, resultSize, unassignedSquares))
+		{
+			std::vector<Vector2i> squaresToFormBlock;
+			for (const Vector2i& offset : BLOCK_SQUARE_OFFSETS[resultSize])
+			{
+				squaresToFormBlock.push_back({ resultSquare.x + offset.x, resultSquare.y + offset.y });
+				unassignedSquares.Remove(squaresToFormBlock.back());
+			}
+			mapBlocksList.emplace_back(std::move(squaresToFormBlock), resultSize, resultAreaType);
+		}
+
+		largeBlocksPlacementAttempts--;
+	}
+
+	// Create standard map blocks with the rest of unassigned squares and add them to the list of all map blocks
+	for (Vector2i unassignedSquare : unassignedSquares.GetFreeList())
+	{
+		AreaType resultAreaType = RANDOM_AREA_TYPES[areaTypeDistribution(randomGenerator)];
+		mapBlocksList.emplace_back(std::vector<Vector2i>{ unassignedSquare }, Size::STANDARD, resultAreaType);
+	}
+
+	IndexBlocks();
+	generation++;
+}
+
+// Remember which block covers every square
+void Map::IndexBlocks()
+{
+	squareBlocks.assign(mapSquareSize * mapSquareSize, -1);
+	for (size_t i = 0; i < mapBlocksList.size(); i++)
+	{
+		for (const Vector2i& square : mapBlocksList[i].GetOccupiedSquares())
+			squareBlocks[square.y * mapSquareSize + square.x] = static_cast<int>(i);
+	}
+}
+
+// Create a list of buildings with their types and positions, and the routing table leading to them
+void Map::GenerateBuildings()
+{
+	CreateBuildings();
+	BuildRoutingTable();
+}
+
+// Create a building on every square of the blocks (except green areas)
+void Map::CreateBuildings()
+{
+	// x and y coordinates of the point where main city rectangle starts to be drawn (top left corner)
+	int citySquareOriginX = -mapPixelSize / 2;
+	int citySquareOriginY = -mapPixelSize / 2;
+
+	buildingsList.clear();
+	squareBuildings.assign(mapSquareSize * mapSquareSize, -1);
+
+	// Generate buildings in the loop for each map block
+	for (const MapBlock& block : mapBlocksList)
+	{
+		for (const Vector2i& square : block.GetOccupiedSquares())
+		{
+			// Get the origin of base occupied square
+			int baseBlockOriginX = citySquareOriginX + ROAD_WIDTH + square.x * (SQUARE_WIDTH + ROAD_WIDTH);
+			int baseBlockOriginY = citySquareOriginY + ROAD_WIDTH + square.y * (SQUARE_WIDTH + ROAD_WIDTH);
+
+			// Determine the type of inheriting class
+			switch (block.GetAreaType())
+			{
+			case AreaType::RESIDENTIAL_AREA:
+				buildingsList.push_back(std::make_unique<House>(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH));
+				break;
+			case AreaType::HOSPITAL:
+				buildingsList.push_back(std::make_unique<Hospital>(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH));
+				break;
+			case AreaType::SHOPPING_AREA:
+				buildingsList.push_back(std::make_unique<Shop>(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH));
+				break;
+			case AreaType::WORKPLACE_AREA:
+				buildingsList.push_back(std::make_unique<Workplace>(baseBlockOriginX, baseBlockOriginY, SQUARE_WIDTH));
+				break;
+			default:
+				continue;
+			}
+			squareBuildings[square.y * mapSquareSize + square.x] = static_cast<int>(buildingsList.size()) - 1;
+		}
+	}
+
+	generation++;
+}
+
+Vector2i Map::PixelToGridPosition(Vector2i pixelPosition) const
+{
+	Vector2i relativePosition = { pixelPosition.x + mapPixelSize / 2, pixelPosition.y + mapPixelSize / 2 };
+
+	return {
+		static_cast<int>(relativePosition.x / (SQUARE_WIDTH + ROAD_WIDTH)),
+		static_cast<int>(relativePosition.y / (SQUARE_WIDTH + ROAD_WIDTH))
+	};
+}
+
+// Square containing the given pixel, or the nearest square of the map for pixels on roads and outside of the map
+Vector2i Map::PixelToSquarePosition(Vector2i pixelPosition) const
+{
+	int squareStride = SQUARE_WIDTH + ROAD_WIDTH;
+	Vector2i relativePosition = { pixelPosition.x + mapPixelSize / 2 - ROAD_WIDTH, pixelPosition.y + mapPixelSize / 2 - ROAD_WIDTH };
+
+	return {
+		std::clamp(static_cast<int>(std::floor(static_cast<float>(relativePosition.x) / squareStride)), 0, mapSquareSize - 1),
+		std::clamp(static_cast<int>(std::floor(static_cast<float>(relativePosition.y) / squareStride)), 0, mapSquareSize - 1)
+	};
+}
+
+Vector2i Map::GridToPixelPosition(Vector2i gridPosition) const
+{
+	Vector2i relativePosition{
+		gridPosition.x * (SQUARE_WIDTH + ROAD_WIDTH) + ROAD_WIDTH / 2,
+		gridPosition.y * (SQUARE_WIDTH + ROAD_WIDTH) + ROAD_WIDTH / 2
+	};
+	return {
+		relativePosition.x - mapPixelSize / 2,
+		relativePosition.y - mapPixelSize / 2
+	};
+}
+
+// Block or open the road leaving the intersection in the given direction (in both ways)
+void Map::SetRoadBlocked(Vector2i intersection, RoadDirection direction, bool blocked)
+{
+	int width = GetIntersectionsWidth();
+	Vector2i neighbour = { intersection.x + ROAD_DIRECTION_OFFSETS[direction].x, intersection.y + ROAD_DIRECTION_OFFSETS[direction].y };
+	if (intersection.x < 0 || intersection.y < 0 || intersection.x >= width || intersection.y >= width
+		|| neighbour.x < 0 || neighbour.y < 0 || neighbour.x >= width || neighbour.y >= width)
+		throw std::out_of_range("Road is outside of the map.");
+
+	RoadDirection oppositeDirection = static_cast<RoadDirection>((direction + 2) % ROAD_DIRECTION_COUNT);
+	uint8_t& roads = blockedRoads[intersection.y * width + intersection.x];
+	uint8_t& neighbourRoads = blockedRoads[neighbour.y * width + neighbour.x];
+	if (blocked)
+	{
+		roads |= 1 << direction;
+		neighbourRoads |= 1 << oppositeDirection;
+	}
+	else
+	{
+		roads &= ~(1 << direction);
+		neighbourRoads &= ~(1 << oppositeDirection);
+	}
+}
+
+// Roads leading outside of the map count as blocked
+bool Map::IsRoadBlocked(Vector2i intersection, RoadDirection direction) const
+{
+	int width = GetIntersectionsWidth();
+	Vector2i neighbour = { intersection.x + ROAD_DIRECTION_OFFSETS[direction].x, intersection.y + ROAD_DIRECTION_OFFSETS[direction].y };
+	if (neighbour.x < 0 || neighbour.y < 0 || neighbour.x >= width || neighbour.y >= width)
+		return true;
+
+	return (blockedRoads[intersection.y * width + intersection.x] >> direction) & 1;
+}
+
+bool Map::HasBlockedRoads() const
+{
+	return std::any_of(blockedRoads.begin(), blockedRoads.end(), [](uint8_t roads) { return roads != 0; });
+}
+
+void Map::BuildRoutingTable(int threadCount)
+{
+	routingTable.Build(*this, threadCount);
+}
\ No newline at end of file
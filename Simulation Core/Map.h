@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "MapBlock.h"
+#include "Building.h"
+#include "RoutingTable.h"
+
+class Map
+{
+private:
+    const int SQUARE_WIDTH = 100;
+    const int ROAD_WIDTH = 30;
+    const float LARGE_BLOCKS_PLACEMENT_INTENSITY = 10.0f;
+
+    std::vector<MapBlock> mapBlocksList;
+    std::vector<std::unique_ptr<Building>> buildingsList;
+    Building* hospitalBuilding = nullptr;
+    int mapSquareSize;
+    int mapPixelSize;
+    std::vector<uint8_t> blockedRoads; // Bit mask of blocked road directions of every intersection
+    RoutingTable routingTable;
+    unsigned int generation = 0;        // Incremented every time the blocks or buildings are generated
+    std::vector<int> squareBlocks;      // Index of the block covering every square (row by row)
+    std::vector<int> squareBuildings;   // Index of the building on every square, -1 for squares without one
+
+    Map() : mapSquareSize(0), mapPixelSize(0) {} // Empty map filled in by Checkpoint when restoring
+    void IndexBlocks();
+    void CreateBuildings();
+    friend class Checkpoint;
+
+public:
+    Map(int populationSize, int residentsInBuildingLimit);
+    void GenerateMap();
+    void GenerateBuildings();
+    Vector2i PixelToGridPosition(Vector2i pixelPosition) const;
+    Vector2i GridToPixelPosition(Vector2i gridPosition) const;
+
+    // Squares of the map work as a spatial index of blocks and buildings, for finding the ones in a part of the map
+    Vector2i PixelToSquarePosition(Vector2i pixelPosition) const;
+    int GetBlockIndexAt(Vector2i square) const { return squareBlocks[square.y * mapSquareSize + square.x]; }
+    int GetBuildingIndexAt(Vector2i square) const { return squareBuildings[square.y * mapSquareSize + square.x]; }
+    const std::vector<MapBlock>& GetMapBlocksList() const { return mapBlocksList; }
+    const std::vector<std::unique_ptr<Building>>& GetBuildingsList() const { return buildingsList; }
+    int GetSquareWidth() const { return SQUARE_WIDTH; }
+    int GetRoadWidth() const { return ROAD_WIDTH; }
+    int GetMapWidth() const { return mapSquareSize; }
+    int GetMapPixelSize() const { return mapPixelSize; }
+    int GetIntersectionsWidth() const { return mapSquareSize + 1; }
+    unsigned int GetGeneration() const { return generation; } // Changes whenever the layout of the map changes
+
+    // Roads between intersections. Routes change only after the routing table is rebuilt
+    void SetRoadBlocked(Vector2i intersection, RoadDirection direction, bool blocked);
+    bool IsRoadBlocked(Vector2i intersection, RoadDirection direction) const;
+    bool HasBlockedRoads() const;
+    void BuildRoutingTable(int threadCount = 0);
+    const RoutingTable& GetRoutingTable() const { return routingTable; }
+};
\ No newline at end of file
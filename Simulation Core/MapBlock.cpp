@@ -7,7 +7,7 @@ MapBlock::MapBlock(std::vector<Vector2i> squaresFormingBlock, Size size, AreaTyp
 	blockSize = size;
 }
 
-std::vector<Vector2i> MapBlock::GetOccupiedSquares() const
+const std::vector<Vector2i>& MapBlock::GetOccupiedSquares() const
 {
 	return occupiedSquares;
 }
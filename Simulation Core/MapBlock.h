@@ -1,11 +1,18 @@
 #pragma once
-#include "raylib-cpp.hpp"
-#include <iostream>
+#include <vector>
 #include "Vector2i.h"
 
 enum AreaType { GREEN_AREA, RESIDENTIAL_AREA, HOSPITAL, SHOPPING_AREA, WORKPLACE_AREA, AREA_COUNT };
 enum Size { DOUBLE_VERTICAL, DOUBLE_HORIZONTAL, QUAD_SQUARE, STANDARD, SIZE_COUNT };
 
+// Squares forming a block of each size, relative to its base square (the top left one)
+inline const std::vector<Vector2i> BLOCK_SQUARE_OFFSETS[SIZE_COUNT] = {
+	{ { 0, 0 }, { 0, 1 } },						// DOUBLE_VERTICAL
+	{ { 0, 0 }, { 1, 0 } },						// DOUBLE_HORIZONTAL
+	{ { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } },	// QUAD_SQUARE
+	{ { 0, 0 } }								// STANDARD
+};
+
 class MapBlock
 {
 private:
@@ -15,7 +22,7 @@ private:
 
 public:
 	MapBlock(std::vector<Vector2i> squaresFormingBlock, Size size, AreaType type);
-	std::vector<Vector2i> GetOccupiedSquares() const;
+	const std::vector<Vector2i>& GetOccupiedSquares() const;
 	Size GetBlockSize() const;
 	AreaType GetAreaType() const;
 };
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "MetricsSink.h"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+const char METRICS_MAGIC[8] = { 'E', 'P', 'I', 'M', 'E', 'T', 'R', 'C' };
+const uint32_t METRICS_VERSION = 2;
+const size_t METRICS_COLUMN_NAME_SIZE = 16;	// Column names are stored zero-padded in the binary header
+
+// Names of the tables (used in file names) and of their columns
+const char* const METRICS_TABLE_NAMES[METRICS_TABLE_COUNT] = { "ticks", "hours", "buildings" };
+const std::vector<const char*> METRICS_COLUMNS[METRICS_TABLE_COUNT] = {
+	{ "tick", "healthy", "exposed", "infected", "immune", "dead" },
+	{ "tick", "day", "hour", "healthy", "exposed", "infected", "immune", "dead" },
+	{ "tick", "building", "healthy", "exposed", "infected", "immune", "dead" }
+};
+
+MetricsSink::MetricsSink(const std::string& pathPrefix, MetricsFormat format, size_t bufferRows, int buffersPerTable) :
+	format(format), bufferRows(bufferRows), writing(false), stopping(false), producerWaits(0)
+{
+	if (bufferRows == 0 || buffersPerTable < 2)
+		throw std::invalid_argument("Metrics sink needs at least two buffers of at least one row per table");
+
+	for (int i = 0; i < METRICS_TABLE_COUNT; i++)
+	{
+		Table& table = tables[i];
+		table.columnCount = static_cast<int>(METRICS_COLUMNS[i].size());
+
+		std::string path = pathPrefix + "_" + METRICS_TABLE_NAMES[i] + (format == MetricsCsv ? ".csv" : ".bin");
+		table.file.open(path, std::ios::binary | std::ios::trunc);
+		if (!table.file)
+			throw std::runtime_error("Can't create metrics file " + path);
+
+		// Header: names of the columns
+		if (format == MetricsCsv)
+		{
+			for (int column = 0; column < table.columnCount; column++)
+				table.file << (column > 0 ? "," : "") << METRICS_COLUMNS[i][column];
+			table.file << '\n';
+		}
+		else
+		{
+			uint32_t columnCount = static_cast<uint32_t>(table.columnCount);
+			table.file.write(METRICS_MAGIC, sizeof(METRICS_MAGIC));
+			table.file.write(reinterpret_cast<const char*>(&METRICS_VERSION), sizeof(METRICS_VERSION));
+			table.file.write(reinterpret_cast<const char*>(&columnCount), sizeof(columnCount));
+			for (const char* name : METRICS_COLUMNS[i])
+			{
+				char paddedName[METRICS_COLUMN_NAME_SIZE] = {};
+				std::strncpy(paddedName, name, METRICS_COLUMN_NAME_SIZE - 1);
+				table.file.write(paddedName, sizeof(paddedName));
+			}
+		}
+
+		// One buffer is being recorded into, the others are free or waiting for the writer
+		table.rows.reserve(bufferRows * table.columnCount);
+		table.freeBuffers.resize(buffersPerTable - 1);
+		for (std::vector<int32_t>& buffer : table.freeBuffers)
+			buffer.reserve(bufferRows * table.columnCount);
+	}
+
+	writer = std::thread(&MetricsSink::WriterLoop, this);
+}
+
+MetricsSink::~MetricsSink()
+{
+	try
+	{
+		Flush();
+	}
+	catch (const std::exception&)
+	{
+		// Nothing can be reported from a destructor, the rows that couldn't be written are lost
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	bufferQueued.notify_all();
+	writer.join();
+}
+
+void MetricsSink::RecordTick(uint32_t tick, const CompartmentCounts& counts)
+{
+	AddRow(TICK_METRICS, { static_cast<int32_t>(tick), counts.healthy, counts.exposed, counts.infected, counts.immune, counts.dead });
+}
+
+void MetricsSink::RecordHour(uint32_t tick, int day, int hour, const CompartmentCounts& counts)
+{
+	AddRow(HOUR_METRICS, { static_cast<int32_t>(tick), day, hour, counts.healthy, counts.exposed, counts.infected, counts.immune, counts.dead });
+}
+
+void MetricsSink::RecordBuildings(uint32_t tick, const std::vector<CompartmentCounts>& buildingCounts)
+{
+	for (size_t building = 0; building < buildingCounts.size(); building++)
+	{
+		const CompartmentCounts& counts = buildingCounts[building];
+		if (counts.healthy + counts.exposed + counts.infected + counts.immune + counts.dead > 0)
+			AddRow(BUILDING_METRICS, { static_cast<int32_t>(tick), static_cast<int32_t>(building), counts.healthy, counts.exposed, counts.infected, counts.immune, counts.dead });
+	}
+}
+
+void MetricsSink::AddRow(MetricsTable table, std::initializer_list<int32_t> values)
+{
+	std::vector<int32_t>& rows = tables[table].rows;
+	rows.insert(rows.end(), values);
+	if (rows.size() >= bufferRows * tables[table].columnCount)
+		SubmitBuffer(table);
+}
+
+// Hand the recorded rows to the writer and continue with a free buffer, waiting for one if all of them are in use
+void MetricsSink::SubmitBuffer(MetricsTable table)
+{
+	Table& recordedTable = tables[table];
+	if (recordedTable.rows.empty())
+		return;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	if (recordedTable.freeBuffers.empty())
+	{
+		producerWaits++;
+		bufferWritten.wait(lock, [&] { return !recordedTable.freeBuffers.empty() || writeError; });
+		if (writeError)
+			std::rethrow_exception(writeError);
+	}
+
+	queue.emplace_back(table, std::move(recordedTable.rows));
+	recordedTable.rows = std::move(recordedTable.freeBuffers.back());
+	recordedTable.freeBuffers.pop_back();
+	lock.unlock();
+	bufferQueued.notify_one();
+}
+
+void MetricsSink::Flush()
+{
+	for (int table = 0; table < METRICS_TABLE_COUNT; table++)
+		SubmitBuffer(static_cast<MetricsTable>(table));
+
+	std::unique_lock<std::mutex> lock(mutex);
+	bufferWritten.wait(lock, [&] { return (queue.empty() && !writing) || writeError; });
+	if (writeError)
+		std::rethrow_exception(writeError);
+}
+
+void MetricsSink::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		bufferQueued.wait(lock, [&] { return stopping || !queue.empty(); });
+		if (queue.empty())
+			return;
+
+		MetricsTable table = queue.front().first;
+		std::vector<int32_t> rows = std::move(queue.front().second);
+		queue.pop_front();
+		writing = true;
+		lock.unlock();
+
+		// Formatting and writing happen without the lock, so recording continues meanwhile
+		std::exception_ptr error;
+		try
+		{
+			WriteBuffer(table, rows);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		lock.lock();
+		rows.clear();
+		tables[table].freeBuffers.push_back(std::move(rows));
+		writing = false;
+		if (error && !writeError)
+			writeError = error;
+		bufferWritten.notify_all();
+	}
+}
+
+void MetricsSink::WriteBuffer(MetricsTable table, const std::vector<int32_t>& rows)
+{
+	Table& writtenTable = tables[table];
+	size_t columnCount = writtenTable.columnCount;
+	size_t rowCount = rows.size() / columnCount;
+
+	if (format == MetricsCsv)
+	{
+		// Format the whole buffer first, so it is written with a single call
+		std::string text(rowCount * columnCount * 12, '\0');
+		char* position = text.data();
+		for (size_t i = 0; i < rows.size(); i++)
+		{
+			position = std::to_chars(position, text.data() + text.size(), rows[i]).ptr;
+			*position++ = (i % columnCount == columnCount - 1) ? '\n' : ',';
+		}
+		writtenTable.file.write(text.data(), position - text.data());
+	}
+	else
+	{
+		// Chunk: number of rows, then every column as an array
+		std::vector<int32_t> columns(rows.size());
+		for (size_t row = 0; row < rowCount; row++)
+			for (size_t column = 0; column < columnCount; column++)
+				columns[column * rowCount + row] = rows[row * columnCount + column];
+
+		uint32_t chunkRows = static_cast<uint32_t>(rowCount);
+		writtenTable.file.write(reinterpret_cast<const char*>(&chunkRows), sizeof(chunkRows));
+		writtenTable.file.write(reinterpret_cast<const char*>(columns.data()), columns.size() * sizeof(int32_t));
+	}
+
+	if (!writtenTable.file.flush())
+		throw std::runtime_error(std::string("Can't write metrics file of table ") + METRICS_TABLE_NAMES[table]);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PopulationStore.h"
+
+const size_t DEFAULT_METRICS_BUFFER_ROWS = 4096;
+const int DEFAULT_METRICS_BUFFERS_PER_TABLE = 4;
+
+enum MetricsFormat
+{
+	MetricsCsv,		// Text, a row per line with a header line of column names
+	MetricsBinary	// Columnar: a header with column names, then chunks of rows stored column after column (32-bit integers)
+};
+
+enum MetricsTable
+{
+	TICK_METRICS,		// Compartment counts after every tick
+	HOUR_METRICS,		// Compartment counts at the start of every hour
+	BUILDING_METRICS,	// Compartment counts of people inside every occupied building
+	METRICS_TABLE_COUNT
+};
+
+// Streams compartment counts of a running simulation into files (one per table, named prefix_ticks.csv and so on).
+// Recording only appends a row to a buffer; full buffers are formatted and written by a background thread.
+// Every table owns a fixed number of buffers, so memory stays bounded: when the writer falls behind,
+// recording waits for a buffer to be written instead of allocating more.
+class MetricsSink
+{
+private:
+	struct Table
+	{
+		int columnCount;
+		std::ofstream file;
+		std::vector<int32_t> rows;	// Rows being recorded, one after another
+		std::vector<std::vector<int32_t>> freeBuffers;
+	};
+
+	MetricsFormat format;
+	size_t bufferRows;
+	Table tables[METRICS_TABLE_COUNT];
+
+	std::thread writer;
+	std::mutex mutex;
+	std::condition_variable bufferQueued;
+	std::condition_variable bufferWritten;
+	std::deque<std::pair<MetricsTable, std::vector<int32_t>>> queue;	// Full buffers waiting for the writer
+	bool writing;
+	bool stopping;
+	std::exception_ptr writeError;
+	unsigned long long producerWaits;
+
+	void AddRow(MetricsTable table, std::initializer_list<int32_t> values);
+	void SubmitBuffer(MetricsTable table);
+	void WriterLoop();
+	void WriteBuffer(MetricsTable table, const std::vector<int32_t>& rows);
+
+public:
+	MetricsSink(const std::string& pathPrefix, MetricsFormat format, size_t bufferRows = DEFAULT_METRICS_BUFFER_ROWS, int buffersPerTable = DEFAULT_METRICS_BUFFERS_PER_TABLE);	// Throws if a file can't be created
+	~MetricsSink();	// Writes everything recorded so far
+	MetricsSink(const MetricsSink&) = delete;
+	MetricsSink& operator=(const MetricsSink&) = delete;
+
+	void RecordTick(uint32_t tick, const CompartmentCounts& counts);
+	void RecordHour(uint32_t tick, int day, int hour, const CompartmentCounts& counts);
+	void RecordBuildings(uint32_t tick, const std::vector<CompartmentCounts>& buildingCounts);	// Only buildings with someone inside are recorded
+	void Flush();	// Write all recorded rows and wait until they are in the files, throws if writing failed
+	unsigned long long GetProducerWaits() const { return producerWaits; }	// Number of times recording had to wait for the writer
+};
\ No newline at end of file
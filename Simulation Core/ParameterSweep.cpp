@@ -0,0 +1,168 @@
+#include "ParameterSweep.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include "Random.h"
+#include "WorkStealingPool.h"
+
+const int MAX_SWEEP_POINTS = 1000000;
+
+ParameterSweep::ParameterSweep(const SweepSettings& settings) : settings(settings), runTime(0.0), mapGenerationTime(0.0), threadCount(0)
+{
+	if (settings.dimensions.empty())
+		throw std::invalid_argument("Parameter sweep needs at least one dimension");
+	if (settings.citySeeds.empty())
+		throw std::invalid_argument("Parameter sweep needs at least one city seed");
+	for (const SweepDimension& dimension : settings.dimensions)
+	{
+		if (!dimension.field)
+			throw std::invalid_argument("Sweep dimension " + dimension.name + " is not a disease parameter");
+		if (settings.sampling == GridSampling && dimension.steps < 1)
+			throw std::invalid_argument("Sweep dimension " + dimension.name + " needs at least one step");
+	}
+
+	if (settings.sampling == GridSampling)
+		CreateGridPoints();
+	else
+		CreateLatinHypercubePoints();
+}
+
+// deathProbabilityPerHourInHospital is not listed, applying the parameters to a population derives it from deathProbabilityPerHour
+float DiseaseParameters::* ParameterSweep::FindParameter(const std::string& name)
+{
+	static const std::pair<const char*, float DiseaseParameters::*> parameters[] = {
+		{ "infectionProbabilityPerHour", &DiseaseParameters::infectionProbabilityPerHour },
+		{ "deathProbabilityPerHour", &DiseaseParameters::deathProbabilityPerHour },
+		{ "probabilityOfGoingToHospitalPerHour", &DiseaseParameters::probabilityOfGoingToHospitalPerHour },
+		{ "hoursToGetImmune", &DiseaseParameters::hoursToGetImmune },
+		{ "hoursToGetSymptoms", &DiseaseParameters::hoursToGetSymptoms },
+		{ "hoursToGetInfectious", &DiseaseParameters::hoursToGetInfectious },
+		{ "infectionRadius", &DiseaseParameters::infectionRadius }
+	};
+
+	for (const auto& parameter : parameters)
+		if (name == parameter.first)
+			return parameter.second;
+	return nullptr;
+}
+
+void ParameterSweep::CreateGridPoints()
+{
+	long long pointCount = 1;
+	for (const SweepDimension& dimension : settings.dimensions)
+	{
+		pointCount *= dimension.steps;
+		if (pointCount > MAX_SWEEP_POINTS)
+			throw std::invalid_argument("Parameter sweep grid has too many points");
+	}
+
+	// The first dimension changes slowest
+	for (long long point = 0; point < pointCount; point++)
+	{
+		DiseaseParameters parameters = settings.run.diseaseParameters;
+		long long remainingIndex = point;
+		for (auto dimension = settings.dimensions.rbegin(); dimension != settings.dimensions.rend(); ++dimension)
+		{
+			int step = static_cast<int>(remainingIndex % dimension->steps);
+			remainingIndex /= dimension->steps;
+			float fraction = dimension->steps > 1 ? static_cast<float>(step) / (dimension->steps - 1) : 0.0f;
+			parameters.*(dimension->field) = dimension->min + fraction * (dimension->max - dimension->min);
+		}
+		points.push_back(parameters);
+	}
+}
+
+// Every dimension is split into sampleCount equal intervals and every interval gets exactly one point,
+// at a random place inside it; the intervals of different dimensions are matched in random order
+void ParameterSweep::CreateLatinHypercubePoints()
+{
+	if (settings.sampleCount < 1 || settings.sampleCount > MAX_SWEEP_POINTS)
+		throw std::invalid_argument("Latin hypercube sampling needs between 1 and a million samples");
+
+	points.assign(settings.sampleCount, settings.run.diseaseParameters);
+	std::mt19937_64 gen(settings.samplingSeed);
+	std::uniform_real_distribution<float> offsetDistribution(0.0f, 1.0f);
+	std::vector<int> intervals(settings.sampleCount);
+
+	for (const SweepDimension& dimension : settings.dimensions)
+	{
+		std::iota(intervals.begin(), intervals.end(), 0);
+		std::shuffle(intervals.begin(), intervals.end(), gen);
+		for (int point = 0; point < settings.sampleCount; point++)
+		{
+			float fraction = (intervals[point] + offsetDistribution(gen)) / settings.sampleCount;
+			points[point].*(dimension.field) = dimension.min + fraction * (dimension.max - dimension.min);
+		}
+	}
+}
+
+void ParameterSweep::Run(int newThreadCount)
+{
+	// Maps come from the shared random generator, so they are generated one after another before the runs
+	auto mapStartTime = std::chrono::steady_clock::now();
+	std::vector<std::unique_ptr<Map>> maps;
+	for (unsigned int citySeed : settings.citySeeds)
+	{
+		SetRandomSeed(citySeed);
+		maps.push_back(std::make_unique<Map>(settings.run.populationSize, settings.run.residentsInBuildingLimit));
+		maps.back()->GenerateMap();
+		maps.back()->GenerateBuildings();
+	}
+	std::chrono::duration<double> mapElapsedTime = std::chrono::steady_clock::now() - mapStartTime;
+	mapGenerationTime = mapElapsedTime.count();
+
+	int cityCount = static_cast<int>(settings.citySeeds.size());
+	results.assign(GetRunCount(), SweepResult{});
+
+	WorkStealingPool pool(newThreadCount);
+	auto startTime = std::chrono::steady_clock::now();
+	pool.Run(GetRunCount(), [&](int run, int) {
+		SweepResult& result = results[run];
+		result.point = run / cityCount;
+		result.citySeed = settings.citySeeds[run % cityCount];
+		result.peakInfected = -1;
+
+		RunSettings runSettings = settings.run;
+		runSettings.diseaseParameters = points[result.point];
+		result.finalCounts = RunSimulation(*maps[run % cityCount], runSettings, result.citySeed, [&result](int hour, const CompartmentCounts& counts) {
+			if (counts.infected > result.peakInfected)
+			{
+				result.peakInfected = counts.infected;
+				result.peakHour = hour + 1;
+			}
+		});
+		result.totalDeaths = result.finalCounts.dead;
+	});
+	std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+	runTime = elapsedTime.count();
+	threadCount = pool.GetThreadCount();
+}
+
+void ParameterSweep::WriteResults(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Can't create sweep file " + path);
+
+	file << "point,city_seed";
+	for (const SweepDimension& dimension : settings.dimensions)
+		file << ',' << dimension.name;
+	file << ",peak_infected,hours_to_peak,total_deaths,final_healthy,final_exposed,final_infected,final_immune\n";
+
+	for (const SweepResult& result : results)
+	{
+		file << result.point << ',' << result.citySeed;
+		for (const SweepDimension& dimension : settings.dimensions)
+			file << ',' << points[result.point].*(dimension.field);
+		file << ',' << result.peakInfected << ',' << result.peakHour << ',' << result.totalDeaths << ',' << result.finalCounts.healthy
+			<< ',' << result.finalCounts.exposed << ',' << result.finalCounts.infected << ',' << result.finalCounts.immune << '\n';
+	}
+
+	if (!file.flush())
+		throw std::runtime_error("Can't write sweep file " + path);
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SimulationRun.h"
+
+// How the points of a sweep are chosen
+enum SweepSampling
+{
+	GridSampling,			// Every combination of evenly spaced values of every dimension
+	LatinHypercubeSampling	// A number of points spread so every dimension has one point in each of as many equal intervals
+};
+
+// Field of DiseaseParameters varied by a sweep, between min and max (both included)
+struct SweepDimension
+{
+	std::string name;
+	float DiseaseParameters::* field;
+	float min;
+	float max;
+	int steps;	// Number of values in a grid, ignored by Latin hypercube sampling
+};
+
+struct SweepSettings
+{
+	std::vector<SweepDimension> dimensions;
+	SweepSampling sampling;
+	int sampleCount;					// Number of points of Latin hypercube sampling
+	uint64_t samplingSeed;
+	std::vector<unsigned int> citySeeds;	// Every point is run on the map generated with each of these seeds (with the same population seed)
+	RunSettings run;					// Base settings, the dimensions replace fields of its disease parameters
+};
+
+// Summary of one run of a sweep
+struct SweepResult
+{
+	int point;
+	unsigned int citySeed;
+	int peakInfected;
+	int peakHour;		// Hours from the start of the simulation to the first hour with the most infected people
+	int totalDeaths;
+	CompartmentCounts finalCounts;
+};
+
+// Runs a scenario for many combinations of disease parameters. Every map is generated once per city seed and shared
+// by all runs on that city; the runs (points times cities) go through a work-stealing pool, one thread each.
+class ParameterSweep
+{
+private:
+	SweepSettings settings;
+	std::vector<DiseaseParameters> points;
+	std::vector<SweepResult> results;
+	double runTime;
+	double mapGenerationTime;
+	int threadCount;
+
+	void CreateGridPoints();
+	void CreateLatinHypercubePoints();
+
+public:
+	explicit ParameterSweep(const SweepSettings& settings);	// Throws if a dimension or the sampling is invalid
+
+	// Name of a field of DiseaseParameters (as in the code) to the field, nullptr if there is no such field
+	static float DiseaseParameters::* FindParameter(const std::string& name);
+
+	void Run(int threadCount);	// Run every point on every city (0 threads uses all hardware threads), throws if a run fails
+
+	const std::vector<DiseaseParameters>& GetPoints() const { return points; }
+	const std::vector<SweepResult>& GetResults() const { return results; }	// Ordered by point, then by city
+	int GetRunCount() const { return static_cast<int>(points.size() * settings.citySeeds.size()); }
+	double GetRunTime() const { return runTime; }	// In seconds, without generating the maps
+	double GetMapGenerationTime() const { return mapGenerationTime; }
+	double GetRunsPerHour() const { return runTime > 0.0 ? GetRunCount() * 3600.0 / runTime : 0.0; }
+	int GetThreadCount() const { return threadCount; }
+
+	void WriteResults(const std::string& path) const;	// CSV with the values of the dimensions and the summary of every run, throws if the file can't be written
+};
\ No newline at end of file
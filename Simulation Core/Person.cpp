@@ -0,0 +1,152 @@
+#include "Person.h"
+#include "ContactKernel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+void Person::UpdatePersonOnHour(int currentHour)
+{
+    const PersonSchedule& schedule = store->schedules[index];
+
+    if (!IsInHospital())
+    {
+        if (currentHour == schedule.workStartHour)
+        {
+            PrepareToMoveToBuilding(store->workplaceBuildings[index]);
+        }
+        else if (currentHour == schedule.workEndHour)
+        {
+            PrepareToMoveToBuilding(store->houses[index]);
+        }
+        else if (currentHour == schedule.shoppingStartHour)
+        {
+            UpdatePosition(store->tick);
+            if (store->reachedDestinations[index])
+                PrepareToMoveToBuilding(store->shoppingBuildings[index]);
+        }
+        else if (currentHour == schedule.shoppingEndHour)
+        {
+            PrepareToMoveToBuilding(store->houses[index]);
+        }
+    }
+}
+
+// Start a trip to the building from where the person is now
+void Person::PrepareToMoveToBuilding(int newBuilding)
+{
+    UpdatePosition(store->tick);
+
+    store->currentBuildings[index] = newBuilding;
+    store->reachedDestinations[index] = false;
+    store->departureTicks[index] = store->tick;
+    store->legStarts[index] = store->positions[index];
+    store->legStartDistances[index] = 0.0f;
+
+    Vector2i& currentIntersection = store->currentIntersections[index];
+    Vector2i& targetIntersection = store->targetIntersections[index];
+    currentIntersection = store->map->PixelToGridPosition(store->positions[index]);
+    targetIntersection = store->buildingIntersections[newBuilding];
+
+    store->nextIntersections[index] = store->map->GetRoutingTable().GetNextIntersection(currentIntersection, targetIntersection);
+    store->nextIntersectionPixels[index] = store->map->GridToPixelPosition(store->nextIntersections[index]);
+}
+
+// Point at the given distance along a leg, which goes along x first and then along y (like the roads between intersections)
+static Vector2i GetPointOnLeg(Vector2i start, Vector2i end, double distance)
+{
+    int distanceX = std::abs(end.x - start.x);
+    if (distance < distanceX)
+        return { start.x + (end.x > start.x ? 1 : -1) * static_cast<int>(distance), start.y };
+    return { end.x, start.y + (end.y > start.y ? 1 : -1) * static_cast<int>(distance - distanceX) };
+}
+
+// The distance walked since the departure follows from the time and the speed, so the cursor is moved over all legs
+// passed since the last update at once and the position is interpolated on the current leg. People that nobody
+// looks at are never updated, and the result doesn't depend on how often the position is updated.
+void Person::UpdatePosition(uint32_t completedTicks)
+{
+    if (store->reachedDestinations[index] || store->states[index] == Dead)
+        return;
+
+    int currentBuilding = store->currentBuildings[index];
+    if (currentBuilding == NO_BUILDING)
+        return;
+
+    Vector2i& position = store->positions[index];
+    Vector2i& legStart = store->legStarts[index];
+    float& legStartDistance = store->legStartDistances[index];
+    Vector2i& currentIntersection = store->currentIntersections[index];
+    Vector2i& nextIntersection = store->nextIntersections[index];
+    Vector2i& nextIntersectionPixel = store->nextIntersectionPixels[index];
+    const Vector2i& targetIntersection = store->targetIntersections[index];
+
+    int64_t walkingTicks = std::max<int64_t>(static_cast<int64_t>(completedTicks) - store->departureTicks[index], 0);
+    double distance = walkingTicks * static_cast<double>(store->movementPerTick);
+
+    while (true)
+    {
+        // The person entered the target building
+        if (currentIntersection == targetIntersection)
+        {
+            position = store->buildingPositions[currentBuilding];
+            store->reachedDestinations[index] = true;
+            return;
+        }
+
+        int legLength = std::abs(nextIntersectionPixel.x - legStart.x) + std::abs(nextIntersectionPixel.y - legStart.y);
+        double distanceOnLeg = distance - legStartDistance;
+        if (distanceOnLeg < legLength)
+        {
+            position = GetPointOnLeg(legStart, nextIntersectionPixel, distanceOnLeg);
+            return;
+        }
+
+        // Without a route to the target the person stays at the last intersection
+        if (nextIntersection == currentIntersection)
+        {
+            position = nextIntersectionPixel;
+            return;
+        }
+
+        // The person passed the next intersection, continue with the leg after it
+        legStartDistance += legLength;
+        legStart = nextIntersectionPixel;
+        currentIntersection = nextIntersection;
+        nextIntersection = store->map->GetRoutingTable().GetNextIntersection(currentIntersection, targetIntersection);
+        nextIntersectionPixel = store->map->GridToPixelPosition(nextIntersection);
+    }
+}
+
+// Continue the trip from the current position as if it started now, so it can go on at another speed
+void Person::RestartTripFromPosition()
+{
+    UpdatePosition(store->tick);
+    double walkedDistance = (static_cast<double>(store->tick) - store->departureTicks[index]) * store->movementPerTick;
+    store->legStartDistances[index] = static_cast<float>(store->legStartDistances[index] - walkedDistance);
+    store->departureTicks[index] = store->tick;
+}
+
+void Person::TryToGetInfected(int contactCount, RandomStream& random, PersonState infectionState)
+{
+    // Chance of getting infected by at least one of the independent contacts
+    double infectionProbability = 1.0 - std::pow(1.0 - store->infectionProbabilityPerTick, contactCount);
+
+    if (random.NextDouble() < infectionProbability && !IsInHospital())
+    {
+        store->SetState(index, infectionState);
+        store->infectionTicks[index] = store->tick;
+    }
+}
+
+bool Person::IsAlive() const
+{
+    return store->states[index] != Dead;
+}
+
+bool Person::CheckCollision(const Person& other) const
+{
+    int64_t contactDistance = GetContactDistance(store->diseaseParameters.infectionRadius);
+    int64_t dx = static_cast<int64_t>(GetPosition().x) - other.GetPosition().x;
+    int64_t dy = static_cast<int64_t>(GetPosition().y) - other.GetPosition().y;
+    return dx * dx + dy * dy < contactDistance * contactDistance;
+}
\ No newline at end of file
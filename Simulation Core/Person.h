@@ -0,0 +1,29 @@
+#pragma once
+#include "PopulationStore.h"
+#include "Random.h"
+#include "Vector2i.h"
+
+// Handle to a single person of the population. The person's data lives in the population's arrays (PopulationStore),
+// so handles are cheap to create and copy, and stay valid as long as the population exists.
+class Person
+{
+private:
+	PopulationStore* store;
+	int index;
+
+public:
+	Person(PopulationStore* store, int index) : store(store), index(index) {}
+	void UpdatePersonOnHour(int currentHour);	// Update the person's current building every hour
+	void PrepareToMoveToBuilding(int newBuilding);
+	void UpdatePosition(uint32_t completedTicks);	// Move the person to where their trip leads after the given number of simulated ticks
+	void RestartTripFromPosition();	// Called before the speed of walking changes
+
+	int GetIndex() const { return index; }
+	Vector2i GetPosition() const { return store->positions[index]; }	// As of the last UpdatePosition
+	bool IsInHospital() const { return store->currentBuildings[index] == store->hospitalBuilding; }
+	PersonState GetState() const { return store->states[index]; }
+
+	void TryToGetInfected(int contactCount, RandomStream& random, PersonState infectionState = Infected);	// Try to get infected by each of the infected people the person collides with
+	bool IsAlive() const;
+	bool CheckCollision(const Person& other) const;
+};
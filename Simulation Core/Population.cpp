@@ -0,0 +1,462 @@
+#include "Population.h"
+#include "DiseaseModel.h"
+#include <random>
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include "Profiler.h"
+
+// Initialize population assigning every person a house and a workplace
+Population::Population(int personCount, const Map* map, const DiseaseParameters& parameters, int residentsInBuildingLimit, uint64_t seed) : store(map, parameters, seed), diseaseProgression(&store), residentsInBuildingLimit(residentsInBuildingLimit), printHourlyCounts(false), positionsTick(-1), infectionMethod(UniformGrid), contactKernel(GetFastestContactKernel()), countContacts(::GetContactKernel(contactKernel))
+{
+    // Get indices of residential and workplace buildings
+    std::vector<int> residentialBuildings;
+    std::vector<int> workplaceBuildings;
+    std::vector<int> shoppingBuildings;
+
+    // Fill residential and workplace buildings lists based on general buildings list
+    const auto& buildingsList = map->GetBuildingsList();
+    for (int i = 0; i < static_cast<int>(buildingsList.size()); ++i)
+    {
+        switch (buildingsList[i]->GetAreaType())
+        {
+        case AreaType::RESIDENTIAL_AREA:
+            residentialBuildings.push_back(i);
+            break;
+        case AreaType::WORKPLACE_AREA:
+            workplaceBuildings.push_back(i);
+            break;
+        case AreaType::SHOPPING_AREA:
+            shoppingBuildings.push_back(i);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (workplaceBuildings.empty()) {
+        throw std::runtime_error("No workplace buildings are available for the population");
+    }
+    if (shoppingBuildings.empty()) {
+        throw std::runtime_error("No shopping buildings are available for the population");
+    }
+    if (store.hospitalBuilding == NO_BUILDING) {
+        throw std::runtime_error("No hospital building available for the population");
+    }
+
+    // Houses that can still accommodate people. A house is swapped with the last one and removed when it gets full,
+    // so every person picks uniformly from the houses that are not full in constant time
+    std::vector<int> availableHouses = residentialBuildings;
+    std::vector<int> residentsCount(buildingsList.size(), 0);
+
+    // Initialize RNG
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<> workplaceDistribution(0, (int)workplaceBuildings.size() - 1);
+    std::uniform_int_distribution<> shopDistribution(0, (int)shoppingBuildings.size() - 1);
+    std::uniform_int_distribution<> immuneDistribution(0, 100);
+
+    // Create people and assign them to buildings
+    store.Reserve(personCount);
+    for (int i = 0; i < personCount; ++i)
+    {
+        // Stop generating people if no buildings are available
+        if (availableHouses.empty()) {
+            throw std::runtime_error("No residential buildings are available for the population");
+        }
+
+        // Randomly select a house from the available ones
+        std::uniform_int_distribution<> houseDistribution(0, (int)availableHouses.size() - 1);
+        int houseIndex = houseDistribution(gen);
+        int selectedHouse = availableHouses[houseIndex];
+        if (++residentsCount[selectedHouse] >= residentsInBuildingLimit)
+        {
+            availableHouses[houseIndex] = availableHouses.back();
+            availableHouses.pop_back();
+        }
+
+        // Randomly select a workplace and a shop for the person
+        int selectedWorkplace = workplaceBuildings[workplaceDistribution(gen)];
+        int selectedShop = shoppingBuildings[shopDistribution(gen)];
+
+        // Set the initial position of the person to the house's position
+        Vector2i initialPosition(buildingsList[selectedHouse]->GetPosition());
+
+        // Select the state of the person
+        PersonState newState;
+        if (i == 0) {
+            newState = Infected; // First person is infected
+        }
+        else {
+            // 10% chance of being immune, otherwise healthy
+            newState = (immuneDistribution(gen) < INITIAL_IMMUNE_PERCENTAGE) ? Immune : Healthy;
+        }
+
+        // Add a new person to the population
+        store.AddPerson(initialPosition, newState, selectedHouse, selectedWorkplace, selectedShop);
+    }
+
+    ResizeSpatialGrid();
+    BuildHourBuckets();
+    diseaseProgression.Reschedule();
+}
+
+// Cells are as large as the collision distance, so colliding people are always in neighbouring cells
+void Population::ResizeSpatialGrid()
+{
+    int mapPixelSize = store.map->GetMapPixelSize();
+    int cellSize = static_cast<int>(std::ceil(store.diseaseParameters.infectionRadius * 2));
+    spatialGrid.Resize({ -mapPixelSize / 2, -mapPixelSize / 2 }, mapPixelSize, cellSize);
+}
+
+// Put every person into the bucket of every distinct hour of their schedule (counting sort by hour)
+void Population::BuildHourBuckets()
+{
+    hourBucketStarts.assign(HOURS_IN_DAY + 1, 0);
+    auto forEachScheduleHour = [](const PersonSchedule& schedule, const std::function<void(int)>& function) {
+        const int hours[] = { schedule.workStartHour, schedule.workEndHour, schedule.shoppingStartHour, schedule.shoppingEndHour };
+        for (int k = 0; k < 4; ++k)
+        {
+            if (hours[k] < HOURS_IN_DAY && std::find(hours, hours + k, hours[k]) == hours + k)
+                function(hours[k]);
+        }
+    };
+
+    for (const PersonSchedule& schedule : store.schedules)
+        forEachScheduleHour(schedule, [&](int hour) { hourBucketStarts[hour + 1]++; });
+    for (int hour = 0; hour < HOURS_IN_DAY; ++hour)
+        hourBucketStarts[hour + 1] += hourBucketStarts[hour];
+
+    std::vector<int> bucketFill(hourBucketStarts.begin(), hourBucketStarts.end() - 1);
+    hourBucketPeople.resize(hourBucketStarts.back());
+    for (int i = 0; i < GetPeopleCount(); ++i)
+        forEachScheduleHour(store.schedules[i], [&](int hour) { hourBucketPeople[bucketFill[hour]++] = i; });
+}
+
+void Population::UpdatePopulationOnHour(int currentHour)
+{
+    PROFILE_SCOPE(PHASE_UPDATE_ON_HOUR);
+    if (currentHour >= 0 && currentHour < HOURS_IN_DAY)
+    {
+        const int* people = hourBucketPeople.data() + hourBucketStarts[currentHour];
+        ParallelFor(hourBucketStarts[currentHour + 1] - hourBucketStarts[currentHour], [&](int begin, int end) {
+            for (int k = begin; k < end; ++k)
+                GetPerson(people[k]).UpdatePersonOnHour(currentHour);
+        });
+    }
+    if (!printHourlyCounts)
+        return;
+
+    CompartmentCounts counts = GetCompartmentCounts();
+    std::cout << "Healthy: " << counts.healthy << ", Exposed: " << counts.exposed << ", Infected: " << counts.infected
+        << ", Immune: " << counts.immune << ", Dead: " << counts.dead << std::endl;
+}
+
+void Population::UpdatePopulationOnTick() {
+    VisitDiseaseModel(store.diseaseModel, [&](auto model) { UpdatePopulationOnTick<decltype(model)>(); });
+}
+
+// Update the whole population by one tick. People are updated in parallel and every random decision comes from
+// the person's own random stream, so the results are the same for any number of threads. The compartment model
+// is picked once per tick, the events and the infection pass below are compiled for it.
+template <class Model>
+void Population::UpdatePopulationOnTick() {
+    uint32_t tick = store.tick;
+
+    // Apply the changes of health due in this tick. Nobody is moved here, the infection pass brings only
+    // the people it tests up to date
+    {
+        PROFILE_SCOPE(PHASE_UPDATE_PEOPLE);
+        diseaseProgression.ApplyEventsDue<Model>();
+    }
+
+    {
+        PROFILE_SCOPE(PHASE_INFECTION);
+        InfectPeople<Model>(tick);
+    }
+    store.tick++;
+
+#ifdef _DEBUG
+    VerifyCompartmentCounts();
+#endif
+}
+
+void Population::InfectPeople(uint32_t tick)
+{
+    VisitDiseaseModel(store.diseaseModel, [&](auto model) { InfectPeople<decltype(model)>(tick); });
+}
+
+void Population::CollectInfectionCandidates()
+{
+    VisitDiseaseModel(store.diseaseModel, [&](auto model) { CollectInfectionCandidates<decltype(model)>(); });
+}
+
+// Find the people that can get infected and the people that infect others in this tick (exposed people are neither)
+template <class Model>
+void Population::CollectInfectionCandidates()
+{
+    infectiousIndices.clear();
+    healthyIndices.clear();
+    for (int i = 0; i < GetPeopleCount(); ++i)
+    {
+        CompartmentRole role = Model::ROLES[store.states[i]];
+        if (role == SUSCEPTIBLE_ROLE)
+            healthyIndices.push_back(i);
+        else if (role == CARRIER_ROLE && Model::IsInfectious(store, i))
+            infectiousIndices.push_back(i);
+    }
+}
+
+// Perform infections in two phases: first count infectious contacts of every healthy person, then let them try to get infected
+template <class Model>
+void Population::InfectPeople(uint32_t tick)
+{
+    CollectInfectionCandidates<Model>();
+    if (infectiousIndices.empty() || healthyIndices.empty())
+        return;
+
+    // Positions after the movement of this tick
+    for (const std::vector<int>* indices : { &healthyIndices, &infectiousIndices })
+    {
+        ParallelFor(static_cast<int>(indices->size()), [&](int begin, int end) {
+            for (int k = begin; k < end; ++k)
+                GetPerson((*indices)[k]).UpdatePosition(tick + 1);
+        });
+    }
+
+    contactCounts.assign(healthyIndices.size(), 0);
+    if (infectionMethod == BruteForce)
+        CountContactsBruteForce();
+    else if (infectionMethod == BuildingOccupancy)
+        CountContactsInBuildings();
+    else
+        CountContactsUniformGrid();
+
+    ParallelFor(static_cast<int>(healthyIndices.size()), [&](int begin, int end) {
+        for (int k = begin; k < end; ++k)
+        {
+            if (contactCounts[k] == 0)
+                continue;
+
+            RandomStream random(store.randomSeed, healthyIndices[k], tick, INFECTION_STREAM);
+            GetPerson(healthyIndices[k]).TryToGetInfected(contactCounts[k], random, Model::INFECTION_STATE);
+        }
+    });
+
+    // Schedule the course of the disease of the newly infected people (one at a time, the queue is shared)
+    for (size_t k = 0; k < healthyIndices.size(); ++k)
+    {
+        if (contactCounts[k] > 0 && store.states[healthyIndices[k]] != Healthy)
+            diseaseProgression.ScheduleInfection<Model>(healthyIndices[k], tick);
+    }
+}
+
+void Population::CountContactsBruteForce()
+{
+    infectiousXs.resize(infectiousIndices.size());
+    infectiousYs.resize(infectiousIndices.size());
+    for (size_t j = 0; j < infectiousIndices.size(); ++j)
+    {
+        infectiousXs[j] = store.positions[infectiousIndices[j]].x;
+        infectiousYs[j] = store.positions[infectiousIndices[j]].y;
+    }
+
+    int contactDistance = GetContactDistance(store.diseaseParameters.infectionRadius);
+    ParallelFor(static_cast<int>(healthyIndices.size()), [&](int begin, int end) {
+        for (int k = begin; k < end; ++k)
+        {
+            Vector2i position = store.positions[healthyIndices[k]];
+            contactCounts[k] = countContacts(position.x, position.y, infectiousXs.data(), infectiousYs.data(), static_cast<int>(infectiousXs.size()), contactDistance);
+        }
+    });
+}
+
+// Same contacts as the brute force pass, but only infectious people from neighbouring cells are tested
+void Population::CountContactsUniformGrid()
+{
+    spatialGrid.Rebuild(store.positions, infectiousIndices);
+
+    int contactDistance = GetContactDistance(store.diseaseParameters.infectionRadius);
+    ParallelFor(static_cast<int>(healthyIndices.size()), [&](int begin, int end) {
+        for (int k = begin; k < end; ++k)
+        {
+            Vector2i position = store.positions[healthyIndices[k]];
+            spatialGrid.ForEachNeighbourRun(position, [&](const int* xs, const int* ys, int count) {
+                contactCounts[k] += countContacts(position.x, position.y, xs, ys, count, contactDistance);
+            });
+        }
+    });
+}
+
+// Building the person is inside of, or NO_BUILDING while walking. Before their first trip people are at home
+int Population::GetOccupiedBuilding(int index) const
+{
+    if (!store.reachedDestinations[index])
+        return NO_BUILDING;
+    return store.currentBuildings[index] != NO_BUILDING ? store.currentBuildings[index] : store.houses[index];
+}
+
+// People inside a building all stand at its position, so each of them collides with every infectious person inside
+// and nobody else (buildings are farther apart than the contact distance). Counting the infectious people of every
+// building gives the same contacts as testing the pairs in time linear in the number of occupants. Only people
+// on the streets are tested on the grid, against the infectious people on the streets; the few contacts between
+// somebody leaving a building and the people still inside are not counted.
+void Population::CountContactsInBuildings()
+{
+    buildingInfectiousCounts.resize(store.buildingPositions.size(), 0);
+    streetInfectiousIndices.clear();
+    for (int infectious : infectiousIndices)
+    {
+        int building = GetOccupiedBuilding(infectious);
+        if (building != NO_BUILDING)
+            buildingInfectiousCounts[building]++;
+        else
+            streetInfectiousIndices.push_back(infectious);
+    }
+
+    spatialGrid.Rebuild(store.positions, streetInfectiousIndices);
+
+    int contactDistance = GetContactDistance(store.diseaseParameters.infectionRadius);
+    ParallelFor(static_cast<int>(healthyIndices.size()), [&](int begin, int end) {
+        for (int k = begin; k < end; ++k)
+        {
+            int building = GetOccupiedBuilding(healthyIndices[k]);
+            if (building != NO_BUILDING)
+            {
+                contactCounts[k] = buildingInfectiousCounts[building];
+                continue;
+            }
+
+            Vector2i position = store.positions[healthyIndices[k]];
+            spatialGrid.ForEachNeighbourRun(position, [&](const int* xs, const int* ys, int count) {
+                contactCounts[k] += countContacts(position.x, position.y, xs, ys, count, contactDistance);
+            });
+        }
+    });
+
+    // Clear only the buildings that were counted, instead of all of them
+    for (int infectious : infectiousIndices)
+    {
+        int building = GetOccupiedBuilding(infectious);
+        if (building != NO_BUILDING)
+            buildingInfectiousCounts[building] = 0;
+    }
+}
+
+// Bring the positions of everyone up to the ticks simulated so far, e.g. before drawing the population
+void Population::UpdatePositions()
+{
+    // Positions only change with the ticks, so drawing a paused simulation costs nothing
+    if (positionsTick == store.tick)
+        return;
+
+    PROFILE_SCOPE(PHASE_UPDATE_PEOPLE);
+    ParallelFor(GetPeopleCount(), [&](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            GetPerson(i).UpdatePosition(store.tick);
+    });
+    positionsTick = store.tick;
+}
+
+void Population::ParallelFor(int count, const std::function<void(int, int)>& function)
+{
+    if (threadPool)
+        threadPool->ParallelFor(count, function);
+    else
+        function(0, count);
+}
+
+void Population::SetThreadCount(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+    if (threadCount <= 1)
+        threadPool.reset();
+    else if (!threadPool || threadPool->GetThreadCount() != threadCount)
+        threadPool = std::make_unique<ThreadPool>(threadCount);
+}
+
+void Population::SetTicksPerHour(int ticksPerHour)
+{
+    if (ticksPerHour <= 0)
+        throw std::invalid_argument("Number of ticks per hour must be positive");
+
+    // Trips in progress continue from where people are at the new speed
+    for (int i = 0; i < GetPeopleCount(); ++i)
+        GetPerson(i).RestartTripFromPosition();
+
+    // The clock and the infection times count ticks, so they are rescaled to keep the simulated hours
+    // (and how long everyone has been infected) the same at the new resolution. The clock driving the simulation
+    // rounds the same way (SimulationTime::SetTicksPerHour), so the hours still change at the same ticks
+    auto rescale = [&](uint32_t ticks) {
+        return static_cast<uint32_t>(std::min<uint64_t>(RescaleTicks(ticks, store.ticksPerHour, ticksPerHour), std::numeric_limits<uint32_t>::max()));
+    };
+    uint32_t tick = rescale(store.tick);
+    for (int i = 0; i < GetPeopleCount(); ++i)
+    {
+        store.infectionTicks[i] = rescale(store.infectionTicks[i]);
+        store.departureTicks[i] = tick;
+    }
+    store.tick = tick;
+    positionsTick = -1;
+
+    store.SetTicksPerHour(ticksPerHour);
+    diseaseProgression.Reschedule();
+}
+
+void Population::SetDiseaseModel(DiseaseModelType model)
+{
+    store.diseaseModel = model;
+    diseaseProgression.Reschedule();
+}
+
+const char* GetInfectionMethodName(InfectionMethod method)
+{
+    switch (method) {
+    case BruteForce:
+        return "brute force";
+    case UniformGrid:
+        return "uniform grid";
+    case BuildingOccupancy:
+        return "building occupancy";
+    default:
+        return "unknown";
+    }
+}
+
+int Population::GetHealthyCount() const {
+    return store.stateCounts[Healthy].load(std::memory_order_relaxed);
+}
+
+int Population::GetExposedCount() const {
+    return store.stateCounts[Exposed].load(std::memory_order_relaxed);
+}
+
+int Population::GetInfectedCount() const {
+    return store.stateCounts[Infected].load(std::memory_order_relaxed);
+}
+
+int Population::GetImmuneCount() const {
+    return store.stateCounts[Immune].load(std::memory_order_relaxed);
+}
+
+int Population::GetDeadCount() const {
+    return store.stateCounts[Dead].load(std::memory_order_relaxed);
+}
+
+// Compare the maintained counts with a full recount of the population
+void Population::VerifyCompartmentCounts() const {
+    CompartmentCounts counts = GetCompartmentCounts();
+    CompartmentCounts recount = store.CountCompartments();
+    if (counts.healthy != recount.healthy || counts.infected != recount.infected || counts.immune != recount.immune || counts.dead != recount.dead
+        || counts.exposed != recount.exposed)
+        throw std::logic_error("Compartment counts don't match the states of the population");
+}
+
+void Population::ChangePopulationParameters(const DiseaseParameters* newDiseaseParameters) {
+    store.ChangeDiseaseParameters(newDiseaseParameters);
+    ResizeSpatialGrid();
+    diseaseProgression.Reschedule();
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+#include "Person.h"
+#include "DiseaseProgression.h"
+#include "SimulationTime.h"
+#include <vector>
+#include "DiseaseParameters.h"
+#include "SpatialGrid.h"
+#include "ContactKernel.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+const int RESIDENTS_IN_BUILDING_LIMIT = 5;
+const int INITIAL_IMMUNE_PERCENTAGE = 5; // Percentage of people that are immune at the start of the simulation
+const int HOURS_IN_DAY = 24;
+
+class SimulationTime;
+
+// Method used to find people that can be infected by an infected person
+enum InfectionMethod
+{
+	BruteForce,	// Test every infected person against every other person
+	UniformGrid,	// Test only people from neighbouring cells of the spatial grid
+	BuildingOccupancy	// People inside a building are in contact with all infectious people inside it, only people on the streets are tested on the grid
+};
+
+const int INFECTION_METHOD_COUNT = 3;
+const char* GetInfectionMethodName(InfectionMethod method);
+
+class Population
+{
+private:
+	PopulationStore store;	// Data of all people, accessed through Person handles
+	DiseaseProgression diseaseProgression;	// Scheduled changes of health of the infected people
+	int residentsInBuildingLimit;
+	bool printHourlyCounts;	// Print the compartment counts to the console every hour, off by default
+
+	// People with a change of schedule in every hour of the day, one bucket after another (schedules never change)
+	std::vector<int> hourBucketStarts;	// Index of the first person of every hour, HOURS_IN_DAY + 1 entries
+	std::vector<int> hourBucketPeople;
+	int64_t positionsTick;	// Tick up to which the positions of all people were last updated, -1 if never
+
+	// Infection pass
+	InfectionMethod infectionMethod;
+	SpatialGrid spatialGrid;
+	std::vector<int> infectiousIndices;	// People that can infect others during the current tick
+	std::vector<int> healthyIndices;	// People that can be infected during the current tick
+	std::vector<int> contactCounts;		// Number of infectious people every healthy person collides with
+	std::vector<int> infectiousXs;		// Coordinates of the infectious people for the brute force pass
+	std::vector<int> infectiousYs;
+	std::vector<int> streetInfectiousIndices;	// Infectious people outside of buildings
+	std::vector<int> buildingInfectiousCounts;	// Infectious people inside every building, zero between the passes
+	ContactKernelType contactKernel;
+	ContactCountFunction countContacts;
+
+	std::unique_ptr<ThreadPool> threadPool;
+
+	void ParallelFor(int count, const std::function<void(int, int)>& function);
+	void BuildHourBuckets();
+	void ResizeSpatialGrid();	// Cells follow the infection radius of the store
+	template <class Model> void UpdatePopulationOnTick();	// Instantiated for every compartment model (DiseaseModel.h)
+	void InfectPeople(uint32_t tick);
+	template <class Model> void InfectPeople(uint32_t tick);	// Instantiated for every compartment model (DiseaseModel.h)
+	void CollectInfectionCandidates();
+	template <class Model> void CollectInfectionCandidates();
+	void CountContactsBruteForce();
+	void CountContactsUniformGrid();
+	void CountContactsInBuildings();
+	int GetOccupiedBuilding(int index) const;
+
+	friend class Checkpoint;
+	friend class BenchmarkScenario;	// Times the infection pass on its own
+	friend class TestScenario;	// Starts the epidemic of the model tests
+
+public:
+	Population(int personCount, const Map* map, const DiseaseParameters& parameters, int residentsInBuildingLimit, uint64_t seed); // Constructor to initialize the population with a given number of people
+	void UpdatePopulationOnHour(int currentHour);	// Update only the people whose schedule changes in this hour
+	void UpdatePopulationOnTick();	// Advance the population by one tick of simulated time
+	void UpdatePositions();	// Positions are only updated for the people the simulation needs, this updates all of them
+	void SetTicksPerHour(int ticksPerHour);	// Resolution of the model, has to match the clock driving the simulation. Keeps the simulated hours of a running simulation
+	int GetTicksPerHour() const { return store.ticksPerHour; }
+	void SetInfectionMethod(InfectionMethod method) { infectionMethod = method; }
+	InfectionMethod GetInfectionMethod() const { return infectionMethod; }
+	void SetDiseaseModel(DiseaseModelType model);	// Reschedules the course of the disease of the infected people
+	DiseaseModelType GetDiseaseModel() const { return store.diseaseModel; }
+	void SetContactKernel(ContactKernelType type) { countContacts = ::GetContactKernel(type); contactKernel = type; }	// Throws if the processor doesn't support it
+	ContactKernelType GetContactKernel() const { return contactKernel; }
+	void SetPrintHourlyCounts(bool print) { printHourlyCounts = print; }
+	void SetThreadCount(int threadCount);	// Number of threads updating the population (0 uses all hardware threads)
+	int GetThreadCount() const { return threadPool ? threadPool->GetThreadCount() : 1; }
+
+	int GetHealthyCount() const;
+	int GetExposedCount() const;
+	int GetInfectedCount() const;
+	int GetImmuneCount() const;
+	int GetDeadCount() const;
+	size_t GetPendingDiseaseEventCount() const { return diseaseProgression.GetPendingEventCount(); }
+	CompartmentCounts GetCompartmentCounts() const { return store.GetCompartmentCounts(); }	// Snapshot of all counts (without a pass over the population)
+	void VerifyCompartmentCounts() const;	// Throws if the counts differ from a full recount (done after every tick in debug builds)
+	void ChangePopulationParameters(const DiseaseParameters* newDiseaseParameters);
+	int GetPeopleCount() const { return static_cast<int>(store.GetSize()); }
+	Person GetPerson(int index) { return Person(&store, index); }
+	const Person GetPerson(int index) const { return Person(const_cast<PopulationStore*>(&store), index); }
+	const PopulationStore& GetStore() const { return store; }
+};
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "PopulationStore.h"
+#include "Random.h"
+#include "SimulationTime.h"
+#include <cmath>
+
+PopulationStore::PopulationStore(const Map* map, const DiseaseParameters& parameters, uint64_t seed) :
+    diseaseParameters(parameters),
+    diseaseModel(SIRD_MODEL),
+    map(map),
+    hospitalBuilding(NO_BUILDING),
+    randomSeed(seed),
+    tick(0),
+    ticksPerHour(0),
+    movementPerTick(0.0f),
+    infectionProbabilityPerTick(0.0)
+{
+    // Cache positions of the buildings, so people don't have to reach the map for them
+    const auto& buildingsList = map->GetBuildingsList();
+    buildingPositions.reserve(buildingsList.size());
+    buildingIntersections.reserve(buildingsList.size());
+    for (size_t i = 0; i < buildingsList.size(); ++i)
+    {
+        buildingPositions.push_back(buildingsList[i]->GetPosition());
+        buildingIntersections.push_back(map->PixelToGridPosition(buildingsList[i]->GetPosition()));
+        if (buildingsList[i]->GetAreaType() == AreaType::HOSPITAL)
+            hospitalBuilding = static_cast<int>(i);
+    }
+
+    for (std::atomic<int>& count : stateCounts)
+        count = 0;
+
+    SetTicksPerHour(DEFAULT_TICKS_PER_HOUR);
+}
+
+// Add a person to the population and return their index
+int PopulationStore::AddPerson(Vector2i initialPosition, PersonState initialState, int assignedHouse, int assignedWorkplaceBuilding, int assignedShoppingBuilding)
+{
+    // Initialize a schedule for the person
+    RandomStream random(randomSeed, states.size(), 0, SCHEDULE_STREAM);
+    int workStart = random.NextInt(5, 8);   // Work starts between 5 AM and 8 AM
+    int workEnd = (workStart + 9) % 24;     // Work lasts for 9 hours
+    int shoppingStart = random.NextInt(workEnd + 1, workEnd + 3);   // Shopping starts after work ends, between 1 and 3 hours later
+    int shoppingEnd = (random.NextInt(shoppingStart + 1, shoppingStart + 2)) % 24;  // Shopping lasts for 1 or 2 hours
+
+    PersonSchedule schedule;
+    schedule.workStartHour = static_cast<uint8_t>(workStart);
+    schedule.workEndHour = static_cast<uint8_t>(workEnd);
+    schedule.shoppingStartHour = static_cast<uint8_t>(shoppingStart);
+    schedule.shoppingEndHour = static_cast<uint8_t>(shoppingEnd);
+
+    positions.push_back(initialPosition);
+    states.push_back(initialState);
+    stateCounts[initialState]++;
+    infectionTicks.push_back(tick);
+
+    houses.push_back(assignedHouse);
+    workplaceBuildings.push_back(assignedWorkplaceBuilding);
+    shoppingBuildings.push_back(assignedShoppingBuilding);
+    currentBuildings.push_back(NO_BUILDING);
+    schedules.push_back(schedule);
+
+    departureTicks.push_back(tick);
+    legStarts.push_back(initialPosition);
+    legStartDistances.push_back(0.0f);
+    currentIntersections.push_back({});
+    nextIntersections.push_back({});
+    nextIntersectionPixels.push_back({});
+    targetIntersections.push_back({});
+    reachedDestinations.push_back(true);
+
+    return static_cast<int>(states.size()) - 1;
+}
+
+void PopulationStore::Reserve(size_t personCount)
+{
+    positions.reserve(personCount);
+    states.reserve(personCount);
+    infectionTicks.reserve(personCount);
+    houses.reserve(personCount);
+    workplaceBuildings.reserve(personCount);
+    shoppingBuildings.reserve(personCount);
+    currentBuildings.reserve(personCount);
+    schedules.reserve(personCount);
+    departureTicks.reserve(personCount);
+    legStarts.reserve(personCount);
+    legStartDistances.reserve(personCount);
+    currentIntersections.reserve(personCount);
+    nextIntersections.reserve(personCount);
+    nextIntersectionPixels.reserve(personCount);
+    targetIntersections.reserve(personCount);
+    reachedDestinations.reserve(personCount);
+}
+
+// Memory taken by a single person in all arrays
+size_t PopulationStore::GetBytesPerPerson() const
+{
+    return sizeof(Vector2i) + sizeof(PersonState) + sizeof(uint32_t)
+        + 4 * sizeof(int) + sizeof(PersonSchedule)
+        + sizeof(uint32_t) + sizeof(Vector2i) + sizeof(float)
+        + 4 * sizeof(Vector2i) + sizeof(uint8_t);
+}
+
+CompartmentCounts PopulationStore::GetCompartmentCounts() const
+{
+    return {
+        stateCounts[Healthy].load(std::memory_order_relaxed),
+        stateCounts[Infected].load(std::memory_order_relaxed),
+        stateCounts[Immune].load(std::memory_order_relaxed),
+        stateCounts[Dead].load(std::memory_order_relaxed),
+        stateCounts[Exposed].load(std::memory_order_relaxed)
+    };
+}
+
+CompartmentCounts PopulationStore::CountCompartments() const
+{
+    int counts[PERSON_STATE_COUNT] = {};
+    for (PersonState state : states)
+        counts[state]++;
+    return { counts[Healthy], counts[Infected], counts[Immune], counts[Dead], counts[Exposed] };
+}
+
+// People walking to a building are not counted until they reach it
+void PopulationStore::CountPeopleInBuildings(std::vector<CompartmentCounts>& buildingCounts) const
+{
+    buildingCounts.assign(buildingPositions.size(), CompartmentCounts{});
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        if (currentBuildings[i] == NO_BUILDING || !reachedDestinations[i])
+            continue;
+
+        CompartmentCounts& counts = buildingCounts[currentBuildings[i]];
+        switch (states[i])
+        {
+        case Healthy:
+            counts.healthy++;
+            break;
+        case Infected:
+            counts.infected++;
+            break;
+        case Immune:
+            counts.immune++;
+            break;
+        case Dead:
+            counts.dead++;
+            break;
+        case Exposed:
+            counts.exposed++;
+            break;
+        }
+    }
+}
+
+// Set the number of ticks a simulated hour is divided into. Only the model's resolution depends on it,
+// the length of the tick in real time is decided by the clock driving the simulation
+void PopulationStore::SetTicksPerHour(int newTicksPerHour)
+{
+    ticksPerHour = newTicksPerHour;
+    movementPerTick = (10.0f * map->GetSquareWidth()) / ticksPerHour;
+    UpdateProbabilitiesPerTick();
+}
+
+// Split the hourly infection probability into a per-tick one, so that ticksPerHour ticks compound exactly to the hourly value
+void PopulationStore::UpdateProbabilitiesPerTick()
+{
+    double tickFraction = 1.0 / ticksPerHour;
+    infectionProbabilityPerTick = 1.0 - std::pow(1.0 - diseaseParameters.infectionProbabilityPerHour, tickFraction);
+}
+
+void PopulationStore::ChangeDiseaseParameters(const DiseaseParameters* newDiseaseParameters) {
+    diseaseParameters.infectionProbabilityPerHour = newDiseaseParameters->infectionProbabilityPerHour;
+    diseaseParameters.deathProbabilityPerHour = newDiseaseParameters->deathProbabilityPerHour;
+    diseaseParameters.hoursToGetImmune = newDiseaseParameters->hoursToGetImmune;
+    diseaseParameters.hoursToGetInfectious = newDiseaseParameters->hoursToGetInfectious;
+    diseaseParameters.infectionRadius = newDiseaseParameters->infectionRadius;
+    diseaseParameters.hoursToGetSymptoms = 0.5f * newDiseaseParameters->hoursToGetSymptoms;
+    diseaseParameters.deathProbabilityPerHourInHospital = 0.5f * newDiseaseParameters->deathProbabilityPerHour;
+    UpdateProbabilitiesPerTick();
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Map.h"
+#include "Vector2i.h"
+#include "DiseaseParameters.h"
+
+enum PersonState : uint8_t
+{
+	Healthy,
+	Infected,
+	Immune,
+	Dead,
+	Exposed	// Infected, but not infectious yet (models with a latent period)
+};
+
+struct PersonSchedule
+{
+	uint8_t workStartHour;
+	uint8_t workEndHour;
+	uint8_t shoppingStartHour;
+	uint8_t shoppingEndHour;
+};
+
+const int PERSON_STATE_COUNT = 5;
+const int NO_BUILDING = -1;
+
+// Number of people in every health state at one moment
+struct CompartmentCounts
+{
+	int healthy;
+	int infected;
+	int immune;
+	int dead;
+	int exposed;
+};
+
+// Data of every person of the population kept in separate arrays (structure of arrays),
+// so loops over the population only read the fields they need. Person is a handle to one entry of these arrays.
+struct PopulationStore
+{
+	// Position and health state of every person
+	std::vector<Vector2i> positions;	// Position after the last update of the person's trip
+	std::vector<PersonState> states;
+	std::vector<uint32_t> infectionTicks;	// Tick in which the person got infected
+
+	// Buildings of every person (indices into the map's buildings list)
+	std::vector<int> houses;				// The building where the person lives
+	std::vector<int> workplaceBuildings;	// The building where the person works
+	std::vector<int> shoppingBuildings;		// The building where the person shops
+	std::vector<int> currentBuildings;		// The building the person is currently in (or moving to)
+	std::vector<PersonSchedule> schedules;	// Daily schedule of the person
+
+	// Trip of every person: the tick it started and the route cursor. Positions follow from them and the time,
+	// and are only brought up to date when somebody needs them (Person::UpdatePosition)
+	std::vector<uint32_t> departureTicks;			// Number of ticks simulated when the trip started
+	std::vector<Vector2i> legStarts;				// Pixel the person walks to the next intersection from
+	std::vector<float> legStartDistances;			// Distance walked since the departure when the leg started
+	std::vector<Vector2i> currentIntersections;		// The current intersection the person is at
+	std::vector<Vector2i> nextIntersections;		// The next intersection the person is moving towards
+	std::vector<Vector2i> nextIntersectionPixels;
+	std::vector<Vector2i> targetIntersections;		// The target intersection the person is moving towards
+	std::vector<uint8_t> reachedDestinations;
+
+	// Number of people in every state, updated at every state change so it never needs a pass over the population
+	std::atomic<int> stateCounts[PERSON_STATE_COUNT];
+
+	// Parameters shared by every person
+	DiseaseParameters diseaseParameters;
+	DiseaseModelType diseaseModel;
+	const Map* map;
+	std::vector<Vector2i> buildingPositions;	// Positions of the map's buildings, indexed like the buildings list
+	std::vector<Vector2i> buildingIntersections;	// Intersections the buildings are entered from
+	int hospitalBuilding;
+	uint64_t randomSeed;	// Seed of the random streams of all people
+	uint32_t tick;			// Number of ticks simulated so far, used as the clock of the model and the counter of the random streams
+
+	// Parameters related to the length of a tick
+	int ticksPerHour;
+	float movementPerTick; // Distance in pixels a person walks during one tick (not rounded, trips are computed from the time)
+	double infectionProbabilityPerTick;	// The course of the disease is scheduled in hours (DiseaseProgression)
+
+	PopulationStore(const Map* map, const DiseaseParameters& parameters, uint64_t seed);
+	int AddPerson(Vector2i initialPosition, PersonState initialState, int assignedHouse, int assignedWorkplaceBuilding, int assignedShoppingBuilding);
+	void Reserve(size_t personCount);
+	size_t GetSize() const { return states.size(); }
+	size_t GetBytesPerPerson() const;
+
+	void SetState(int index, PersonState newState)	// Change the state of the person keeping the state counts up to date (safe to call from parallel loops)
+	{
+		stateCounts[states[index]].fetch_sub(1, std::memory_order_relaxed);
+		stateCounts[newState].fetch_add(1, std::memory_order_relaxed);
+		states[index] = newState;
+	}
+	CompartmentCounts GetCompartmentCounts() const;
+	CompartmentCounts CountCompartments() const;	// Count the states with a full pass over the population
+	void CountPeopleInBuildings(std::vector<CompartmentCounts>& buildingCounts) const;	// Count the states of people inside every building (indexed like the buildings list), positions have to be up to date
+
+	float GetHoursSinceInfected(int index) const { return static_cast<float>(tick - infectionTicks[index]) / ticksPerHour; }
+
+	void SetTicksPerHour(int newTicksPerHour);
+	void UpdateProbabilitiesPerTick();
+	void ChangeDiseaseParameters(const DiseaseParameters* newDiseaseParameters);
+};
@@ -0,0 +1,146 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+const char* const PROFILE_PHASE_NAMES[PROFILE_PHASE_COUNT] = {
+	"Frame", "Advance time", "Update on hour", "Update people", "Infection", "Graph update", "Draw map", "Draw people", "Draw interface", "Present"
+};
+
+thread_local bool Profiler::profilingThread = false;
+
+Profiler& GetProfiler()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+Profiler::Profiler() : phases(), windowFrames(0), nextFrame(0), tracing(false)
+{
+	creationTime = std::chrono::steady_clock::now();
+	frameStartTime = creationTime;
+}
+
+// Buckets grow exponentially, bucket b starts at 2^(b / PROFILE_BUCKETS_PER_OCTAVE) microseconds
+int Profiler::GetBucket(int64_t nanoseconds)
+{
+	double microseconds = nanoseconds / 1000.0;
+	if (microseconds <= 1.0)
+		return 0;
+	int bucket = static_cast<int>(std::log2(microseconds) * PROFILE_BUCKETS_PER_OCTAVE);
+	return std::min(bucket, PROFILE_HISTOGRAM_BUCKETS - 1);
+}
+
+double Profiler::GetBucketStart(int bucket)
+{
+	return std::exp2(static_cast<double>(bucket) / PROFILE_BUCKETS_PER_OCTAVE) / 1000.0;
+}
+
+void Profiler::AddSample(ProfilePhase phase, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+	int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	PhaseHistory& history = phases[phase];
+	history.currentFrameTime += duration;
+	history.currentFrameCalls++;
+	history.totalTime += duration;
+	history.totalCalls++;
+
+	if (tracing)
+	{
+		if (traceEvents.size() < MAX_TRACE_EVENTS)
+			traceEvents.push_back({ phase, std::chrono::duration_cast<std::chrono::nanoseconds>(start - creationTime).count(), duration });
+		else
+			tracing = false;
+	}
+}
+
+void Profiler::EndFrame()
+{
+	auto now = std::chrono::steady_clock::now();
+	AddSample(PHASE_FRAME, frameStartTime, now);
+	frameStartTime = now;
+
+	for (PhaseHistory& history : phases)
+	{
+		// The oldest frame leaves the window once it is full
+		if (windowFrames == PROFILE_WINDOW_FRAMES)
+		{
+			history.histogram[GetBucket(history.frameTimes[nextFrame])]--;
+			history.windowSum -= history.frameTimes[nextFrame];
+		}
+
+		history.frameTimes[nextFrame] = history.currentFrameTime;
+		history.histogram[GetBucket(history.currentFrameTime)]++;
+		history.windowSum += history.currentFrameTime;
+		history.lastFrameCalls = history.currentFrameCalls;
+		history.currentFrameTime = 0;
+		history.currentFrameCalls = 0;
+	}
+
+	windowFrames = std::min(windowFrames + 1, PROFILE_WINDOW_FRAMES);
+	nextFrame = (nextFrame + 1) % PROFILE_WINDOW_FRAMES;
+}
+
+// Walk the histogram up to the bucket containing the percentile and interpolate inside it
+double Profiler::GetPercentile(const PhaseHistory& history, double percentile) const
+{
+	double target = percentile * windowFrames;
+	int seen = 0;
+	for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; bucket++)
+	{
+		int count = history.histogram[bucket];
+		if (count > 0 && seen + count >= target)
+		{
+			double fraction = (target - seen) / count;
+			double bucketStart = bucket == 0 ? 0.0 : GetBucketStart(bucket);	// The first bucket also holds everything shorter
+			return bucketStart + fraction * (GetBucketStart(bucket + 1) - bucketStart);
+		}
+		seen += count;
+	}
+	return 0.0;
+}
+
+PhaseStatistics Profiler::GetStatistics(ProfilePhase phase) const
+{
+	const PhaseHistory& history = phases[phase];
+	PhaseStatistics statistics = {};
+	if (windowFrames == 0)
+		return statistics;
+
+	statistics.mean = history.windowSum / 1e6 / windowFrames;
+	statistics.median = GetPercentile(history, 0.5);
+	statistics.percentile95 = GetPercentile(history, 0.95);
+	statistics.max = *std::max_element(history.frameTimes, history.frameTimes + windowFrames) / 1e6;
+	statistics.callsInLastFrame = history.lastFrameCalls;
+	return statistics;
+}
+
+void Profiler::StartTrace()
+{
+	traceEvents.clear();
+	traceEvents.reserve(MAX_TRACE_EVENTS / 16);
+	tracing = true;
+}
+
+void Profiler::WriteChromeTrace(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Can't create trace file " + path);
+
+	// Complete ("X") events with times in microseconds; frames and the phases inside them nest on one thread
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	file.precision(3);
+	file << std::fixed;
+	for (size_t i = 0; i < traceEvents.size(); i++)
+	{
+		const TraceEvent& event = traceEvents[i];
+		file << (i > 0 ? ",\n" : "\n") << "{\"name\":\"" << PROFILE_PHASE_NAMES[event.phase] << "\",\"cat\":\"simulation\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+			<< event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0 << "}";
+	}
+	file << "\n]}\n";
+
+	if (!file.flush())
+		throw std::runtime_error("Can't write trace file " + path);
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Profiling is compiled in unless ENABLE_PROFILING is defined as 0, then PROFILE_SCOPE expands to nothing
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING 1
+#endif
+
+// Phases of a frame of the simulation, each timed as a whole (never per person)
+enum ProfilePhase
+{
+	PHASE_FRAME,			// Whole frame, from one EndFrame to the next
+	PHASE_ADVANCE_TIME,
+	PHASE_UPDATE_ON_HOUR,
+	PHASE_UPDATE_PEOPLE,	// Changes of health due in the tick and positions of all people brought up to date
+	PHASE_INFECTION,
+	PHASE_GRAPH_UPDATE,
+	PHASE_DRAW_MAP,
+	PHASE_DRAW_PEOPLE,
+	PHASE_DRAW_INTERFACE,
+	PHASE_PRESENT,			// Ending the drawing, including the wait for the frame rate limit
+	PROFILE_PHASE_COUNT
+};
+
+extern const char* const PROFILE_PHASE_NAMES[PROFILE_PHASE_COUNT];
+
+const int PROFILE_WINDOW_FRAMES = 240;	// Frames the statistics are computed over
+const int PROFILE_BUCKETS_PER_OCTAVE = 4;
+const int PROFILE_HISTOGRAM_BUCKETS = 21 * PROFILE_BUCKETS_PER_OCTAVE;	// From 1 microsecond to 2 seconds
+const size_t MAX_TRACE_EVENTS = 1 << 20;
+
+// Time spent in a phase per frame over the last frames, in milliseconds. Percentiles come from the histogram,
+// so they are accurate to about a fifth of their value
+struct PhaseStatistics
+{
+	double mean;
+	double median;
+	double percentile95;
+	double max;
+	int callsInLastFrame;
+};
+
+// Collects the time of every phase of every frame: a rolling window of the per-frame totals with a histogram of them
+// (kept up to date as frames enter and leave the window), and optionally every timed scope as a trace event.
+// Only the thread that enabled profiling is timed, so the same code running on other threads (e.g. ensemble replicates)
+// costs a single check per scope.
+class Profiler
+{
+private:
+	struct PhaseHistory
+	{
+		int64_t frameTimes[PROFILE_WINDOW_FRAMES];	// Nanoseconds per frame, ring buffer
+		int histogram[PROFILE_HISTOGRAM_BUCKETS];	// Number of frames of the window in every bucket
+		int64_t windowSum;
+		int64_t currentFrameTime;
+		int currentFrameCalls;
+		int lastFrameCalls;
+		int64_t totalTime;		// Since the profiler was created
+		long long totalCalls;
+	};
+
+	struct TraceEvent
+	{
+		ProfilePhase phase;
+		int64_t start;		// Nanoseconds since the profiler was created
+		int64_t duration;
+	};
+
+	static thread_local bool profilingThread;
+
+	std::chrono::steady_clock::time_point creationTime;
+	std::chrono::steady_clock::time_point frameStartTime;
+	PhaseHistory phases[PROFILE_PHASE_COUNT];
+	int windowFrames;	// Frames in the window, up to PROFILE_WINDOW_FRAMES
+	int nextFrame;		// Position of the next frame in the ring buffers
+
+	bool tracing;
+	std::vector<TraceEvent> traceEvents;
+
+	static int GetBucket(int64_t nanoseconds);
+	static double GetBucketStart(int bucket);	// In milliseconds
+	double GetPercentile(const PhaseHistory& history, double percentile) const;
+
+public:
+	Profiler();
+
+	void EnableOnThisThread() { profilingThread = true; }	// Time the scopes executed by the calling thread
+	static bool IsProfilingThread() { return profilingThread; }
+
+	void AddSample(ProfilePhase phase, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+	void EndFrame();	// Move the times of the finished frame into the window
+	PhaseStatistics GetStatistics(ProfilePhase phase) const;
+	const int* GetHistogram(ProfilePhase phase) const { return phases[phase].histogram; }
+	double GetTotalTime(ProfilePhase phase) const { return phases[phase].totalTime / 1e6; }	// In milliseconds, over all frames
+	long long GetTotalCalls(ProfilePhase phase) const { return phases[phase].totalCalls; }
+
+	void StartTrace();	// Record every timed scope from now on (up to MAX_TRACE_EVENTS of them)
+	void StopTrace() { tracing = false; }
+	bool IsTracing() const { return tracing; }
+	size_t GetTraceEventCount() const { return traceEvents.size(); }
+	void WriteChromeTrace(const std::string& path) const;	// Trace event JSON for chrome://tracing or Perfetto, throws if the file can't be written
+};
+
+Profiler& GetProfiler();
+
+// Times the rest of the enclosing scope as a phase, if the current thread is profiled
+class ScopedTimer
+{
+private:
+	ProfilePhase phase;
+	bool active;
+	std::chrono::steady_clock::time_point start;
+
+public:
+	explicit ScopedTimer(ProfilePhase phase) : phase(phase), active(Profiler::IsProfilingThread())
+	{
+		if (active)
+			start = std::chrono::steady_clock::now();
+	}
+	~ScopedTimer()
+	{
+		if (active)
+			GetProfiler().AddSample(phase, start, std::chrono::steady_clock::now());
+	}
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#if ENABLE_PROFILING
+#define PROFILE_CONCATENATE_INNER(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_INNER(a, b)
+#define PROFILE_SCOPE(phase) ScopedTimer PROFILE_CONCATENATE(scopedTimer, __LINE__)(phase)
+#else
+#define PROFILE_SCOPE(phase) ((void)0)
+#endif
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "Random.h"
+
+std::mt19937& GetRandomGenerator()
+{
+	static std::mt19937 randomGenerator(std::random_device{}());
+	return randomGenerator;
+}
+
+void SetRandomSeed(unsigned int seed)
+{
+	GetRandomGenerator().seed(seed);
+}
\ No newline at end of file
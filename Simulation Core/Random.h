@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <random>
+
+// Random number generator shared by the whole simulation, so a run can be repeated with the same seed
+std::mt19937& GetRandomGenerator();
+void SetRandomSeed(unsigned int seed);
+
+// What the random values of a stream are used for, so different decisions of a person in the same tick are independent
+enum RandomStreamPurpose : uint32_t
+{
+	SCHEDULE_STREAM,
+	PROGRESSION_STREAM,	// Course of the disease, drawn once per infection
+	INFECTION_STREAM
+};
+
+// Scramble the bits of a 64-bit value (SplitMix64 finalizer)
+inline uint64_t MixBits(uint64_t value)
+{
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+// Counter-based random stream. Every value depends only on (seed, stream id, tick, purpose) and the number of values
+// drawn before it, so people can be updated in any order and on any number of threads with the same results.
+class RandomStream
+{
+private:
+	uint64_t key;
+	uint64_t counter;
+
+public:
+	RandomStream(uint64_t seed, uint64_t streamId, uint64_t tick, RandomStreamPurpose purpose)
+		: key(MixBits(MixBits(MixBits(seed ^ purpose) ^ streamId) ^ tick)), counter(0) {}
+
+	uint64_t NextUInt64() { return MixBits(key + 0xD1B54A32D192ED03ull * ++counter); }
+	float NextFloat() { return static_cast<float>(NextUInt64() >> 40) * (1.0f / 16777216.0f); }	// Random value in [0, 1)
+	double NextDouble() { return static_cast<double>(NextUInt64() >> 11) * (1.0 / 9007199254740992.0); }	// Random value in [0, 1) with full double precision
+	int NextInt(int min, int max)	// Random value between min and max (both included)
+	{
+		if (min > max)
+			std::swap(min, max);
+		return min + static_cast<int>(NextUInt64() % (static_cast<uint64_t>(max - min) + 1));
+	}
+};
@@ -0,0 +1,200 @@
+#include "RoutingTable.h"
+#include "Map.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+
+RoutingTable::RoutingTable() : width(0), fieldStride(0), destinationCount(0), usesFlowFields(false), buildTime(0.0)
+{
+}
+
+void RoutingTable::Build(const Map& map, int threadCount)
+{
+	auto startTime = std::chrono::steady_clock::now();
+
+	width = map.GetIntersectionsWidth();
+	int intersectionCount = width * width;
+	fieldStride = (intersectionCount + 3) / 4;
+
+	// Every building is entered from the intersection at the top left corner of its square
+	destinationFields.assign(intersectionCount, -1);
+	std::vector<int> destinations;
+	for (const auto& building : map.GetBuildingsList())
+	{
+		int intersection = GetIntersectionIndex(map.PixelToGridPosition(building->GetPosition()));
+		if (destinationFields[intersection] == -1)
+		{
+			destinationFields[intersection] = static_cast<int>(destinations.size());
+			destinations.push_back(intersection);
+		}
+	}
+
+	// Bit mask of open roads of every intersection, so searches don't have to check the map's bounds
+	std::vector<uint8_t> openRoads(intersectionCount, 0);
+	std::vector<int> columns(intersectionCount);
+	for (int i = 0; i < intersectionCount; i++)
+	{
+		columns[i] = i % width;
+		for (int direction = 0; direction < ROAD_DIRECTION_COUNT; direction++)
+			if (!map.IsRoadBlocked({ i % width, i / width }, static_cast<RoadDirection>(direction)))
+				openRoads[i] |= 1 << direction;
+	}
+
+	FindComponents(openRoads);
+	destinationCount = static_cast<int>(destinations.size());
+
+	// On an open map the flow fields would only hold the L-shaped routes, so they are skipped when they would take too much memory
+	usesFlowFields = destinations.size() * fieldStride <= MAX_FLOW_FIELDS_MEMORY || map.HasBlockedRoads();
+	if (!usesFlowFields)
+	{
+		flowFields.clear();
+		flowFields.shrink_to_fit();
+		std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+		buildTime = elapsedTime.count();
+		return;
+	}
+
+	try {
+		flowFields.assign(destinations.size() * fieldStride, 0);
+	}
+	catch (const std::bad_alloc&) {
+		throw std::runtime_error("Not enough memory for the routing table of the map with blocked roads.");
+	}
+
+	// Flow fields are independent of each other, so they are built in parallel
+	if (threadCount <= 0)
+		threadCount = static_cast<int>(std::thread::hardware_concurrency());
+	ThreadPool threadPool(threadCount);
+	threadPool.ParallelFor(static_cast<int>(destinations.size()), [&](int begin, int end) {
+		std::vector<int> distances(intersectionCount);
+		std::vector<int> queue(intersectionCount);
+		for (int i = begin; i < end; i++)
+			BuildFlowField(openRoads, columns, destinations[i], &flowFields[static_cast<size_t>(i) * fieldStride], distances, queue);
+	}, 16);
+
+	std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+	buildTime = elapsedTime.count();
+}
+
+// Label intersections connected by open roads
+void RoutingTable::FindComponents(const std::vector<uint8_t>& openRoads)
+{
+	const int offsets[ROAD_DIRECTION_COUNT] = { 1, width, -1, -width };
+	components.assign(width * width, -1);
+	std::vector<int> stack;
+	int componentCount = 0;
+
+	for (int start = 0; start < width * width; start++)
+	{
+		if (components[start] != -1)
+			continue;
+
+		components[start] = componentCount;
+		stack.push_back(start);
+		while (!stack.empty())
+		{
+			int current = stack.back();
+			stack.pop_back();
+			for (int direction = 0; direction < ROAD_DIRECTION_COUNT; direction++)
+			{
+				int neighbour = current + offsets[direction];
+				if ((openRoads[current] >> direction & 1) && components[neighbour] == -1)
+				{
+					components[neighbour] = componentCount;
+					stack.push_back(neighbour);
+				}
+			}
+		}
+		componentCount++;
+	}
+}
+
+// Breadth-first search from the destination, then point every intersection at a neighbour one road closer to it
+void RoutingTable::BuildFlowField(const std::vector<uint8_t>& openRoads, const std::vector<int>& columns, int destination, uint8_t* field, std::vector<int>& distances, std::vector<int>& queue) const
+{
+	const int offsets[ROAD_DIRECTION_COUNT] = { 1, width, -1, -width };
+	std::fill(distances.begin(), distances.end(), -1);
+	distances[destination] = 0;
+	int queueBegin = 0, queueEnd = 0;
+	queue[queueEnd++] = destination;
+
+	while (queueBegin < queueEnd)
+	{
+		int current = queue[queueBegin++];
+		for (int direction = 0; direction < ROAD_DIRECTION_COUNT; direction++)
+		{
+			int neighbour = current + offsets[direction];
+			if ((openRoads[current] >> direction & 1) && distances[neighbour] == -1)
+			{
+				distances[neighbour] = distances[current] + 1;
+				queue[queueEnd++] = neighbour;
+			}
+		}
+	}
+
+	int targetColumn = destination % width;
+	int targetRowStart = destination - targetColumn;
+	for (int i = 1; i < queueEnd; i++)
+	{
+		int current = queue[i];
+
+		// Prefer going along x towards the target, then along y, so open maps keep the L-shaped routes
+		bool towardsEast = columns[current] < targetColumn;
+		bool towardsSouth = current < targetRowStart;
+		const RoadDirection preferred[ROAD_DIRECTION_COUNT] = {
+			towardsEast ? ROAD_EAST : ROAD_WEST,
+			towardsSouth ? ROAD_SOUTH : ROAD_NORTH,
+			towardsEast ? ROAD_WEST : ROAD_EAST,
+			towardsSouth ? ROAD_NORTH : ROAD_SOUTH
+		};
+
+		for (RoadDirection direction : preferred)
+		{
+			if ((openRoads[current] >> direction & 1) && distances[current + offsets[direction]] == distances[current] - 1)
+			{
+				field[current >> 2] |= static_cast<uint8_t>(direction << ((current & 3) * 2));
+				break;
+			}
+		}
+	}
+}
+
+Vector2i RoutingTable::GetNextIntersection(Vector2i currentIntersection, Vector2i targetIntersection) const
+{
+	if (currentIntersection == targetIntersection || !IsReachable(currentIntersection, targetIntersection))
+		return currentIntersection;
+
+	int fieldIndex = destinationFields[GetIntersectionIndex(targetIntersection)];
+	if (fieldIndex == -1)
+		return currentIntersection;
+
+	if (!usesFlowFields)
+	{
+		Vector2i nextIntersection = currentIntersection;
+		if (currentIntersection.x != targetIntersection.x)
+			nextIntersection.x += currentIntersection.x < targetIntersection.x ? 1 : -1;
+		else
+			nextIntersection.y += currentIntersection.y < targetIntersection.y ? 1 : -1;
+		return nextIntersection;
+	}
+
+	int current = GetIntersectionIndex(currentIntersection);
+	int direction = (flowFields[static_cast<size_t>(fieldIndex) * fieldStride + (current >> 2)] >> ((current & 3) * 2)) & 3;
+	return { currentIntersection.x + ROAD_DIRECTION_OFFSETS[direction].x, currentIntersection.y + ROAD_DIRECTION_OFFSETS[direction].y };
+}
+
+bool RoutingTable::IsReachable(Vector2i fromIntersection, Vector2i toIntersection) const
+{
+	if (fromIntersection.x < 0 || fromIntersection.y < 0 || fromIntersection.x >= width || fromIntersection.y >= width
+		|| toIntersection.x < 0 || toIntersection.y < 0 || toIntersection.x >= width || toIntersection.y >= width)
+		return false;
+
+	return components[GetIntersectionIndex(fromIntersection)] == components[GetIntersectionIndex(toIntersection)];
+}
+
+size_t RoutingTable::GetMemoryUsage() const
+{
+	return flowFields.size() * sizeof(uint8_t) + destinationFields.size() * sizeof(int) + components.size() * sizeof(int);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vector2i.h"
+
+class Map;
+
+const size_t MAX_FLOW_FIELDS_MEMORY = 128 * 1024 * 1024;	// Larger open maps use the L-shaped routes directly instead of flow fields
+
+// Directions of the roads leaving an intersection
+enum RoadDirection : uint8_t
+{
+	ROAD_EAST,
+	ROAD_SOUTH,
+	ROAD_WEST,
+	ROAD_NORTH,
+	ROAD_DIRECTION_COUNT
+};
+
+inline const Vector2i ROAD_DIRECTION_OFFSETS[ROAD_DIRECTION_COUNT] = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
+
+// Next-hop table for walking between intersections of the map. For every intersection a building is reached from,
+// a flow field stores the direction of the first road of a shortest path from each other intersection (2 bits per intersection),
+// so a step of a person is a single lookup. Among equally short paths the one going along x first is chosen.
+class RoutingTable
+{
+private:
+	int width;		// Number of intersections in a row (and in a column)
+	int fieldStride;	// Bytes taken by a single flow field
+	int destinationCount;
+	std::vector<int> destinationFields;	// Index of the flow field leading to each intersection, -1 if no building is reached from it
+	std::vector<int> components;		// Connected component of each intersection, paths exist only inside a component
+	std::vector<uint8_t> flowFields;
+	bool usesFlowFields;	// False for open maps too large for flow fields, where the shortest routes are computed directly
+	double buildTime;	// Time the last build took (in seconds)
+
+	int GetIntersectionIndex(Vector2i intersection) const { return intersection.y * width + intersection.x; }
+	void FindComponents(const std::vector<uint8_t>& openRoads);
+	void BuildFlowField(const std::vector<uint8_t>& openRoads, const std::vector<int>& columns, int destination, uint8_t* field, std::vector<int>& distances, std::vector<int>& queue) const;
+
+	friend class Checkpoint;
+
+public:
+	RoutingTable();
+	void Build(const Map& map, int threadCount = 0);	// Build flow fields for all buildings of the map (0 threads uses all hardware threads), throws if they don't fit in memory
+	Vector2i GetNextIntersection(Vector2i currentIntersection, Vector2i targetIntersection) const;	// Returns the current intersection when the target can't be reached
+	bool IsReachable(Vector2i fromIntersection, Vector2i toIntersection) const;
+
+	int GetDestinationCount() const { return destinationCount; }
+	bool UsesFlowFields() const { return usesFlowFields; }
+	size_t GetMemoryUsage() const;	// Memory taken by the table (in bytes)
+	double GetBuildTime() const { return buildTime; }
+};
\ No newline at end of file
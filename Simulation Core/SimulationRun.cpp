@@ -0,0 +1,30 @@
+#include "SimulationRun.h"
+#include "SimulationTime.h"
+
+CompartmentCounts RunSimulation(const Map& map, const RunSettings& settings, uint64_t seed, const std::function<void(int, const CompartmentCounts&)>& onHour)
+{
+	DiseaseParameters diseaseParameters = settings.diseaseParameters;
+	Population population(settings.populationSize, &map, diseaseParameters, settings.residentsInBuildingLimit, seed);
+	population.SetInfectionMethod(settings.infectionMethod);
+	population.ChangePopulationParameters(&diseaseParameters);
+	population.SetDiseaseModel(settings.diseaseModel);
+	SimulationTime simulationTime(1.0f, settings.ticksPerHour);
+	population.SetTicksPerHour(simulationTime.GetTicksPerHour());
+
+	int hour = 0;
+	while (simulationTime.GetDay() <= settings.days)
+	{
+		simulationTime.AdvanceTick();
+
+		if (simulationTime.HasHourChanged())
+		{
+			population.UpdatePopulationOnHour(simulationTime.GetHour());
+			if (onHour)
+				onHour(hour, population.GetCompartmentCounts());
+			hour++;
+		}
+
+		population.UpdatePopulationOnTick();
+	}
+	return population.GetCompartmentCounts();
+}
\ No newline at end of file
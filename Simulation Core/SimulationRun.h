@@ -0,0 +1,23 @@
+#pragma once
+#include <functional>
+#include <cstdint>
+#include "DiseaseParameters.h"
+#include "Map.h"
+#include "Population.h"
+
+// Settings of a single headless run on an already generated map
+struct RunSettings
+{
+	int days;
+	int populationSize;
+	int residentsInBuildingLimit;
+	int ticksPerHour;
+	InfectionMethod infectionMethod;
+	DiseaseParameters diseaseParameters;
+	DiseaseModelType diseaseModel;
+};
+
+// Simulate the given number of days on one thread, exactly like the headless simulator does with the same seed.
+// The map is only read, so many runs can share it at the same time. onHour (if set) gets the index of the hour
+// (from 0 for 1 o'clock of day 1) and the counts at its start. Returns the counts at the end of the run
+CompartmentCounts RunSimulation(const Map& map, const RunSettings& settings, uint64_t seed, const std::function<void(int, const CompartmentCounts&)>& onHour = nullptr);
\ No newline at end of file
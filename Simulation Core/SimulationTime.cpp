@@ -0,0 +1,79 @@
+#include "SimulationTime.h"
+#include <stdexcept>
+
+uint64_t RescaleTicks(uint64_t ticks, int fromTicksPerHour, int toTicksPerHour)
+{
+	return ticks * static_cast<uint64_t>(toTicksPerHour) / static_cast<uint64_t>(fromTicksPerHour);
+}
+
+SimulationTime::SimulationTime(float hourLengthInSeconds, int ticksPerHour) :
+	hourLength(hourLengthInSeconds),
+	timeScale(1.0f),
+	ticksPerHour(ticksPerHour),
+	maxTicksPerAdvance(DEFAULT_MAX_TICKS_PER_ADVANCE),
+	timeAccumulator(0.0),
+	tickInHour(0),
+	hour(0),
+	day(1),
+	hourChanged(false)
+{
+	if (ticksPerHour <= 0)
+		throw std::invalid_argument("Number of ticks per hour must be positive");
+}
+
+int SimulationTime::AdvanceTime(float deltaTime)
+{
+	double tickLength = static_cast<double>(hourLength) / (timeScale * ticksPerHour);
+	timeAccumulator += deltaTime;
+
+	int ticks = static_cast<int>(timeAccumulator / tickLength);
+	timeAccumulator -= ticks * tickLength;
+
+	// Drop the time the simulation can't catch up with
+	if (ticks > maxTicksPerAdvance)
+		ticks = maxTicksPerAdvance;
+
+	return ticks;
+}
+
+void SimulationTime::AdvanceTick()
+{
+	tickInHour++;
+	if (tickInHour == ticksPerHour)
+	{
+		tickInHour = 0;
+		hour = (hour + 1) % 24;
+		if (hour == 0)
+			day++;
+
+		hourChanged = true;
+	}
+}
+
+bool SimulationTime::HasHourChanged()
+{
+	if (hourChanged)
+	{
+		hourChanged = false;
+		return true;
+	}
+	else return false;
+}
+
+void SimulationTime::ChangeHourLength(float newTime) {
+	hourLength = newTime;
+}
+
+void SimulationTime::SetTimeScale(float newTimeScale) {
+	if (newTimeScale <= 0.0f)
+		throw std::invalid_argument("Time scale must be positive");
+	timeScale = newTimeScale;
+}
+
+void SimulationTime::SetTicksPerHour(int newTicksPerHour)
+{
+	if (newTicksPerHour <= 0)
+		throw std::invalid_argument("Number of ticks per hour must be positive");
+	tickInHour = static_cast<int>(RescaleTicks(tickInHour, ticksPerHour, newTicksPerHour));
+	ticksPerHour = newTicksPerHour;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+const int DEFAULT_TICKS_PER_HOUR = 60;
+const int DEFAULT_MAX_TICKS_PER_ADVANCE = 10000;
+
+// Ticks at another resolution covering the same simulated time, rounded down. The clock and the population both rescale
+// with it, so after a change of the ticks per hour they still agree on the tick within the hour
+uint64_t RescaleTicks(uint64_t ticks, int fromTicksPerHour, int toTicksPerHour);
+
+// Fixed-timestep clock of the simulation. Simulated time advances in whole ticks (ticksPerHour per hour),
+// real time given to AdvanceTime is converted into the number of ticks that are due and the remainder is kept for later.
+class SimulationTime
+{
+private:
+	float hourLength; // Length of the simulation's hour in seconds
+	float timeScale; // How many times faster than the hour length the simulation runs
+	int ticksPerHour;
+	int maxTicksPerAdvance; // Limit of ticks returned at once, so a slow frame doesn't make the simulation fall further behind
+	double timeAccumulator; // Real time not converted to ticks yet (in seconds)
+	int tickInHour;
+	int hour;
+	int day;
+	bool hourChanged;
+
+	friend class Checkpoint;
+
+public:
+	SimulationTime(float hourLengthInSeconds = 1.0f, int ticksPerHour = DEFAULT_TICKS_PER_HOUR);
+	int AdvanceTime(float deltaTime); // Accumulate real time and return how many ticks should be simulated
+	void AdvanceTick(); // Advance simulated time by one tick
+	int GetHour() const { return hour; }
+	int GetDay() const { return day; }
+	int GetTickInHour() const { return tickInHour; }
+	int GetTicksPerHour() const { return ticksPerHour; }
+	float GetHourLength() const { return hourLength; }
+	float GetTimeScale() const { return timeScale; }
+	bool HasHourChanged();
+	void ChangeHourLength(float newTime);
+	void SetTimeScale(float newTimeScale);
+	void SetTicksPerHour(int newTicksPerHour);	// Keeps the part of the current hour that has passed
+	void SetMaxTicksPerAdvance(int newMaxTicks) { maxTicksPerAdvance = newMaxTicks; }
+};
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+
+// Set up the grid to cover a square area of the map with cells of the given size
+void SpatialGrid::Resize(Vector2i gridOrigin, int gridPixelSize, int newCellSize)
+{
+	origin = gridOrigin;
+	cellSize = std::max(newCellSize, 1);
+	columns = gridPixelSize / cellSize + 1;
+	rows = columns;
+
+	cellStart.assign(columns * rows + 1, 0);
+	cellEntries.clear();
+	entryXs.clear();
+	entryYs.clear();
+}
+
+int SpatialGrid::GetCellIndex(Vector2i position) const
+{
+	int column = std::clamp((position.x - origin.x) / cellSize, 0, columns - 1);
+	int row = std::clamp((position.y - origin.y) / cellSize, 0, rows - 1);
+	return row * columns + column;
+}
+
+// Sort the given people into cells based on their positions (counting sort, so people in a cell stay in index order)
+void SpatialGrid::Rebuild(const std::vector<Vector2i>& positions, const std::vector<int>& indices)
+{
+	std::fill(cellStart.begin(), cellStart.end(), 0);
+	entryCells.resize(indices.size());
+	cellEntries.resize(indices.size());
+
+	// Count people in every cell
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		entryCells[i] = GetCellIndex(positions[indices[i]]);
+		cellStart[entryCells[i] + 1]++;
+	}
+
+	// Turn the counts into offsets of the first entry of every cell
+	for (size_t cell = 1; cell < cellStart.size(); cell++)
+		cellStart[cell] += cellStart[cell - 1];
+
+	// Place people in their cells
+	entryXs.resize(indices.size());
+	entryYs.resize(indices.size());
+	cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		int entry = cellFill[entryCells[i]]++;
+		cellEntries[entry] = indices[i];
+		entryXs[entry] = positions[indices[i]].x;
+		entryYs[entry] = positions[indices[i]].y;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "Vector2i.h"
+
+// Uniform grid over the map used to find people close enough to collide without testing every pair
+class SpatialGrid
+{
+private:
+	Vector2i origin;	// Pixel position of the top left corner of the grid
+	int cellSize;
+	int columns;
+	int rows;
+
+	std::vector<int> cellStart;		// Index of the first entry of every cell (cells are stored one after another)
+	std::vector<int> cellEntries;	// Indices of people sorted by the cell they are in
+	std::vector<int> entryXs;		// Coordinates of the people in the order of cellEntries, so a run of cells
+	std::vector<int> entryYs;		// can be tested against a point with a batch kernel
+	std::vector<int> entryCells;	// Cell of every inserted person, kept between rebuilds to avoid reallocations
+	std::vector<int> cellFill;		// Next free entry of every cell while rebuilding
+
+	int GetCellIndex(Vector2i position) const;
+
+public:
+	SpatialGrid() : origin(0, 0), cellSize(1), columns(0), rows(0) {}
+	void Resize(Vector2i gridOrigin, int gridPixelSize, int newCellSize);
+	void Rebuild(const std::vector<Vector2i>& positions, const std::vector<int>& indices);
+	int GetCellSize() const { return cellSize; }
+
+	// Call function(index) for every person from the cell of the given position and all neighbouring cells
+	template <typename Function>
+	void ForEachNeighbourCandidate(Vector2i position, Function function) const
+	{
+		if (columns == 0)
+			return;
+
+		int cell = GetCellIndex(position);
+		int column = cell % columns;
+		int row = cell / columns;
+
+		for (int y = std::max(row - 1, 0); y <= std::min(row + 1, rows - 1); y++)
+		{
+			for (int x = std::max(column - 1, 0); x <= std::min(column + 1, columns - 1); x++)
+			{
+				int neighbourCell = y * columns + x;
+				for (int entry = cellStart[neighbourCell]; entry < cellStart[neighbourCell + 1]; entry++)
+					function(cellEntries[entry]);
+			}
+		}
+	}
+
+	// Call function(xs, ys, count) with the coordinates of the people from the cell of the given position and all
+	// neighbouring cells. Neighbouring cells of a row are stored one after another, so there are at most three runs
+	template <typename Function>
+	void ForEachNeighbourRun(Vector2i position, Function function) const
+	{
+		if (columns == 0)
+			return;
+
+		int cell = GetCellIndex(position);
+		int column = cell % columns;
+		int row = cell / columns;
+		int firstColumn = std::max(column - 1, 0);
+		int lastColumn = std::min(column + 1, columns - 1);
+
+		for (int y = std::max(row - 1, 0); y <= std::min(row + 1, rows - 1); y++)
+		{
+			int first = cellStart[y * columns + firstColumn];
+			int end = cellStart[y * columns + lastColumn + 1];
+			if (end > first)
+				function(entryXs.data() + first, entryYs.data() + first, end - first);
+		}
+	}
+
+	// Call function(index) for every person from the cells overlapping the rectangle between the given corners
+	template <typename Function>
+	void ForEachInRectangle(Vector2i minPosition, Vector2i maxPosition, Function function) const
+	{
+		if (columns == 0)
+			return;
+
+		int firstCell = GetCellIndex(minPosition);
+		int lastCell = GetCellIndex(maxPosition);
+
+		for (int y = firstCell / columns; y <= lastCell / columns; y++)
+		{
+			int rowStart = y * columns;
+			for (int entry = cellStart[rowStart + firstCell % columns]; entry < cellStart[rowStart + lastCell % columns + 1]; entry++)
+				function(cellEntries[entry]);
+		}
+	}
+};
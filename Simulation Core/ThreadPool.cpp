@@ -0,0 +1,87 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) : task(nullptr), itemCount(0), chunkSize(DEFAULT_CHUNK_SIZE), chunkCount(0), nextChunk(0), busyWorkers(0), generation(0), stopping(false)
+{
+	for (int i = 1; i < threadCount; i++)
+		workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+void ThreadPool::WorkerLoop()
+{
+	unsigned long long finishedGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			workAvailable.wait(lock, [&] { return stopping || generation != finishedGeneration; });
+			if (stopping)
+				return;
+			finishedGeneration = generation;
+		}
+
+		RunChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			busyWorkers--;
+		}
+		workFinished.notify_one();
+	}
+}
+
+// Take chunks of the current loop until none are left
+void ThreadPool::RunChunks()
+{
+	int chunk;
+	while ((chunk = nextChunk.fetch_add(1)) < chunkCount)
+	{
+		int begin = chunk * chunkSize;
+		(*task)(begin, std::min(begin + chunkSize, itemCount));
+	}
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int, int)>& function, int newChunkSize)
+{
+	if (count <= 0)
+		return;
+
+	// Small loops and pools without workers run on the calling thread only
+	if (workers.empty() || count <= newChunkSize)
+	{
+		function(0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task = &function;
+		itemCount = count;
+		chunkSize = newChunkSize;
+		chunkCount = (count + chunkSize - 1) / chunkSize;
+		nextChunk = 0;
+		busyWorkers = static_cast<int>(workers.size());
+		generation++;
+	}
+	workAvailable.notify_all();
+
+	// The calling thread works on the loop too
+	RunChunks();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	workFinished.wait(lock, [&] { return busyWorkers == 0; });
+	task = nullptr;
+}
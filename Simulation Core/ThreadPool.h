@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads splitting loops over the population into chunks
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::condition_variable workFinished;
+
+	// Currently executed loop
+	const std::function<void(int, int)>* task;
+	int itemCount;
+	int chunkSize;
+	int chunkCount;
+	std::atomic<int> nextChunk;
+	int busyWorkers;
+	unsigned long long generation;	// Increased with every loop, so workers know there is new work
+	bool stopping;
+
+	void WorkerLoop();
+	void RunChunks();
+
+public:
+	static const int DEFAULT_CHUNK_SIZE = 1024;
+
+	explicit ThreadPool(int threadCount);	// Number of threads including the calling one
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int GetThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+	void ParallelFor(int count, const std::function<void(int, int)>& function, int chunkSize = DEFAULT_CHUNK_SIZE);	// Call function(begin, end) for chunks of [0, count) and wait for all of them
+};
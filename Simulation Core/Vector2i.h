@@ -1,4 +1,5 @@
 #pragma once
+#include <cmath>
 
 struct Vector2i
 {
@@ -18,11 +19,6 @@ struct Vector2i
 		return !(x == v2.x && y == v2.y);
 	}
 
-	raylib::Vector2 Vector2iToVector2() const
-	{
-		return raylib::Vector2(static_cast<float>(x), static_cast<float>(y));
-	}
-
 	int DistanceTo(const Vector2i& v2) const
 	{
 		int dx = x - v2.x;
@@ -0,0 +1,90 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(int threadCount) : threadCount(threadCount), failed(false), steals(0)
+{
+	if (this->threadCount <= 0)
+		this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	for (int i = 0; i < this->threadCount; i++)
+		queues.push_back(std::make_unique<WorkerQueue>());
+}
+
+// Take the next task of the worker's own queue, or steal one from the other queues
+bool WorkStealingPool::TakeTask(int worker, int& task)
+{
+	{
+		WorkerQueue& queue = *queues[worker];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+
+	// Tasks are never added during a run, so once every queue was seen empty there is nothing left to do
+	for (int i = 1; i < threadCount; i++)
+	{
+		WorkerQueue& victim = *queues[(worker + i) % threadCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			steals++;
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkStealingPool::WorkerLoop(int worker, const std::function<void(int, int)>& function, std::exception_ptr& error, std::mutex& errorMutex)
+{
+	int task;
+	while (!failed && TakeTask(worker, task))
+	{
+		try
+		{
+			function(task, worker);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error)
+				error = std::current_exception();
+			failed = true;
+		}
+	}
+}
+
+void WorkStealingPool::Run(int taskCount, const std::function<void(int, int)>& function)
+{
+	// Every thread starts with a contiguous block of tasks
+	for (int worker = 0; worker < threadCount; worker++)
+	{
+		int begin = static_cast<int>(static_cast<long long>(taskCount) * worker / threadCount);
+		int end = static_cast<int>(static_cast<long long>(taskCount) * (worker + 1) / threadCount);
+		std::deque<int>& tasks = queues[worker]->tasks;
+		tasks.clear();
+		for (int task = begin; task < end; task++)
+			tasks.push_back(task);
+	}
+	failed = false;
+
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	std::vector<std::thread> workers;
+	for (int worker = 1; worker < threadCount; worker++)
+		workers.emplace_back(&WorkStealingPool::WorkerLoop, this, worker, std::cref(function), std::ref(error), std::ref(errorMutex));
+
+	// The calling thread works on the tasks too
+	WorkerLoop(0, function, error, errorMutex);
+	for (std::thread& thread : workers)
+		thread.join();
+
+	if (error)
+		std::rethrow_exception(error);
+}
\ No newline at end of file
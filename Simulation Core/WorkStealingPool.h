@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Threads running independent tasks of uneven length, such as whole simulation runs.
+// Every thread has its own queue of tasks and takes them from the front; a thread whose queue is empty
+// steals from the back of another thread's queue, so threads don't sit idle while others still have long tasks queued.
+// The tasks are long, so the queues are simply guarded by a mutex each.
+class WorkStealingPool
+{
+private:
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<int> tasks;
+	};
+
+	int threadCount;
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	std::atomic<bool> failed;
+	std::atomic<unsigned long long> steals;
+
+	bool TakeTask(int worker, int& task);
+	void WorkerLoop(int worker, const std::function<void(int, int)>& function, std::exception_ptr& error, std::mutex& errorMutex);
+
+public:
+	explicit WorkStealingPool(int threadCount);	// Number of threads including the calling one (0 uses all hardware threads)
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	int GetThreadCount() const { return threadCount; }
+	unsigned long long GetSteals() const { return steals; }	// Number of tasks taken from another thread's queue so far
+
+	// Call function(task, worker) for every task in [0, taskCount) and wait for all of them.
+	// If a task throws, the remaining tasks are skipped and the first exception is rethrown
+	void Run(int taskCount, const std::function<void(int, int)>& function);
+};
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "DiseaseModel.h"
+#include "DiseaseParameters.h"
+#include "Map.h"
+#include "Population.h"
+#include "Random.h"
+#include "SimulationTime.h"
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Tests of the rules the model has to keep, in particular when its parameters change in the middle of a run
+//
+// Usage: Tests [NAME...]
+//
+// Runs the named tests (all of them without names), prints PASS or FAIL with the reason for every test and returns
+// the number of failed tests. CMake registers every test with CTest on its own (ctest --test-dir BUILD_DIRECTORY).
+
+const int TEST_POPULATION = 2000;           // People in the scenario of the tests
+const int RESIDENTS_LIMIT = 4;
+const unsigned int TEST_SEED = 1;
+const int WARMUP_HOURS = 2;                 // People leave their houses before the epidemic starts
+const int INFECTED_PERCENTAGE = 10;         // Share of healthy people infected at the start of the epidemic
+const int TEST_HOURS = 6;                   // Hours simulated before the parameters of a test change
+
+// The same disease as in the headless simulator
+DiseaseParameters GetTestDiseaseParameters()
+{
+    DiseaseParameters diseaseParameters;
+    diseaseParameters.infectionProbabilityPerHour = 0.05f;
+    diseaseParameters.deathProbabilityPerHour = 0.005f;
+    diseaseParameters.hoursToGetImmune = 24.0f;
+    diseaseParameters.hoursToGetSymptoms = 12.0f;
+    diseaseParameters.hoursToGetInfectious = 6.0f;
+    diseaseParameters.infectionRadius = 20.0f;
+    diseaseParameters.probabilityOfGoingToHospitalPerHour = 0.01f;
+    diseaseParameters.deathProbabilityPerHourInHospital = 0.002f;
+    return diseaseParameters;
+}
+
+// Small city at the start of an epidemic, with the clock driving it like in the headless simulator
+class TestScenario
+{
+public:
+    DiseaseParameters diseaseParameters;
+    std::unique_ptr<Map> map;
+    std::unique_ptr<Population> population;
+    SimulationTime simulationTime;
+
+    TestScenario() : diseaseParameters(GetTestDiseaseParameters())
+    {
+        SetRandomSeed(TEST_SEED);
+        map = std::make_unique<Map>(TEST_POPULATION, RESIDENTS_LIMIT);
+        map->GenerateMap();
+        map->GenerateBuildings();
+
+        population = std::make_unique<Population>(TEST_POPULATION, map.get(), diseaseParameters, RESIDENTS_LIMIT, TEST_SEED);
+        population->ChangePopulationParameters(&diseaseParameters);
+        population->SetTicksPerHour(simulationTime.GetTicksPerHour());
+        RunTicks(WARMUP_HOURS * simulationTime.GetTicksPerHour());
+
+        // Infect every few healthy people
+        PopulationStore& store = population->store;
+        int healthySeen = 0;
+        for (int i = 0; i < population->GetPeopleCount(); i++) {
+            if (store.states[i] == Healthy && healthySeen++ % (100 / INFECTED_PERCENTAGE) == 0) {
+                store.SetState(i, Infected);
+                store.infectionTicks[i] = store.tick;
+            }
+        }
+        population->diseaseProgression.Reschedule();
+    }
+
+    // Infected people become exposed as if they were infected in the current tick, the course of their disease is scheduled again
+    void ExposeInfectedPeople()
+    {
+        PopulationStore& store = population->store;
+        for (int i = 0; i < population->GetPeopleCount(); i++) {
+            if (store.states[i] == Infected) {
+                store.SetState(i, Exposed);
+                store.infectionTicks[i] = store.tick;
+            }
+        }
+        population->diseaseProgression.Reschedule();
+    }
+
+    void RunTicks(int count)
+    {
+        for (int tick = 0; tick < count; tick++) {
+            simulationTime.AdvanceTick();
+            if (simulationTime.HasHourChanged())
+                population->UpdatePopulationOnHour(simulationTime.GetHour());
+            population->UpdatePopulationOnTick();
+        }
+    }
+
+    void RunHours(float hours)
+    {
+        RunTicks(static_cast<int>(std::ceil(hours * simulationTime.GetTicksPerHour())));
+    }
+
+    void SetTicksPerHour(int ticksPerHour)
+    {
+        simulationTime.SetTicksPerHour(ticksPerHour);
+        population->SetTicksPerHour(ticksPerHour);
+    }
+
+    std::vector<int> GetPeopleInState(PersonState state) const
+    {
+        std::vector<int> people;
+        for (int i = 0; i < population->GetPeopleCount(); i++) {
+            if (population->GetPerson(i).GetState() == state)
+                people.push_back(i);
+        }
+        return people;
+    }
+};
+
+void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::logic_error(message);
+}
+
+void CheckNobodyInState(const TestScenario& scenario, const std::vector<int>& people, PersonState state, const std::string& message)
+{
+    for (int i : people)
+        Check(scenario.population->GetPerson(i).GetState() != state, "person " + std::to_string(i) + " " + message);
+}
+
+// Recovery of the people infected before the change is already overdue with a shorter disease, so it happens in the next tick
+void TestOverdueRecovery(TestScenario& scenario)
+{
+    scenario.RunHours(TEST_HOURS);
+
+    DiseaseParameters shorterDisease = scenario.diseaseParameters;
+    shorterDisease.hoursToGetImmune = TEST_HOURS / 2.0f;
+    std::vector<int> infected;
+    for (int i : scenario.GetPeopleInState(Infected)) {
+        if (scenario.population->GetStore().GetHoursSinceInfected(i) > shorterDisease.hoursToGetImmune)
+            infected.push_back(i);
+    }
+    Check(!infected.empty(), "nobody is infected");
+
+    scenario.population->ChangePopulationParameters(&shorterDisease);
+    scenario.RunTicks(1);
+    CheckNobodyInState(scenario, infected, Infected, "is still infected");
+}
+
+// Halving the ticks per hour keeps the hours since the infection, so everybody still recovers in time
+void TestTicksPerHour(TestScenario& scenario)
+{
+    scenario.RunHours(TEST_HOURS);
+
+    std::vector<int> infected = scenario.GetPeopleInState(Infected);
+    std::vector<float> hoursSinceInfected;
+    for (int i : infected)
+        hoursSinceInfected.push_back(scenario.population->GetStore().GetHoursSinceInfected(i));
+
+    int ticksPerHour = DEFAULT_TICKS_PER_HOUR / 2;
+    scenario.SetTicksPerHour(ticksPerHour);
+    for (size_t k = 0; k < infected.size(); k++) {
+        float hours = scenario.population->GetStore().GetHoursSinceInfected(infected[k]);
+        Check(std::abs(hours - hoursSinceInfected[k]) <= 1.0f / ticksPerHour, "person " + std::to_string(infected[k]) + " was infected at another hour");
+    }
+
+    // Infection ticks are rounded down to the new resolution, so the recovery can come a tick later
+    scenario.RunTicks(static_cast<int>(std::ceil(scenario.diseaseParameters.hoursToGetImmune * ticksPerHour)) + 2);
+    CheckNobodyInState(scenario, infected, Infected, "is still infected");
+}
+
+// After a change to a number of ticks per hour that doesn't divide the old one, the clock and the population still agree on the hour
+void TestClockTicksPerHour(TestScenario& scenario)
+{
+    scenario.RunTicks(DEFAULT_TICKS_PER_HOUR - 1);
+
+    const int ticksPerHour = 7;
+    scenario.SetTicksPerHour(ticksPerHour);
+    for (int tick = 0; tick < TEST_HOURS * ticksPerHour; tick++) {
+        const SimulationTime& clock = scenario.simulationTime;
+        uint32_t storeTick = scenario.population->GetStore().tick;
+        Check(static_cast<int>(storeTick % ticksPerHour) == clock.GetTickInHour()
+            && static_cast<int>(storeTick / ticksPerHour) == (clock.GetDay() - 1) * 24 + clock.GetHour(),
+            "the clock is at another tick than the population");
+        scenario.RunTicks(1);
+    }
+}
+
+// Nobody gets infected while all carriers are in the latent period of the SEIR model, infections start after it
+void TestSeirLatentPeriod(TestScenario& scenario)
+{
+    Population& population = *scenario.population;
+    population.SetDiseaseModel(SEIR_MODEL);
+    scenario.ExposeInfectedPeople();
+
+    int exposedCount = population.GetExposedCount();
+    int healthyCount = population.GetHealthyCount();
+    Check(exposedCount > 0, "nobody is exposed");
+    int latentTicks = static_cast<int>(std::floor(scenario.diseaseParameters.hoursToGetInfectious * scenario.simulationTime.GetTicksPerHour()));
+    for (int tick = 0; tick < latentTicks; tick++) {
+        scenario.RunTicks(1);
+        Check(population.GetHealthyCount() == healthyCount && population.GetInfectedCount() == 0, "somebody was infected in the latent period");
+    }
+    Check(population.GetExposedCount() == exposedCount, "exposed people left the latent period early");
+
+    scenario.RunHours(TEST_HOURS);
+    Check(population.GetExposedCount() + population.GetInfectedCount() > 0 && population.GetHealthyCount() < healthyCount,
+        "nobody was infected after the latent period");
+}
+
+struct ModelTest
+{
+    const char* name;
+    std::function<void(TestScenario&)> run;
+};
+
+const std::vector<ModelTest> MODEL_TESTS = {
+    { "overdue_recovery", TestOverdueRecovery },
+    { "ticks_per_hour", TestTicksPerHour },
+    { "clock_ticks_per_hour", TestClockTicksPerHour },
+    { "seir_latent_period", TestSeirLatentPeriod }
+};
+
+// Every test gets a scenario of its own and the compartment counts are checked after it
+bool RunTest(const ModelTest& test)
+{
+    try {
+        TestScenario scenario;
+        test.run(scenario);
+        scenario.population->VerifyCompartmentCounts();
+        std::cout << "PASS " << test.name << std::endl;
+        return true;
+    }
+    catch (const std::exception& exception) {
+        std::cout << "FAIL " << test.name << ": " << exception.what() << std::endl;
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int failed = 0;
+    if (argc == 1) {
+        for (const ModelTest& test : MODEL_TESTS)
+            failed += RunTest(test) ? 0 : 1;
+        return failed;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        bool found = false;
+        for (const ModelTest& test : MODEL_TESTS) {
+            if (std::strcmp(argv[i], test.name) == 0) {
+                failed += RunTest(test) ? 0 : 1;
+                found = true;
+            }
+        }
+        if (!found) {
+            std::cout << "FAIL " << argv[i] << ": no such test" << std::endl;
+            failed++;
+        }
+    }
+    return failed;
+}
\ No newline at end of file